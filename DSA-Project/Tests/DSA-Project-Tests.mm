@@ -7,7 +7,23 @@
 
 #import <XCTest/XCTest.h>
 #include "array.h"
+#include "roaring_set.h"
 #include "strings.h"
+#include "string_kernels.h"
+#include "permutations.h"
+#include "string_search.h"
+#include "utf8.h"
+#include "loser_tree.h"
+#include "merge_path.h"
+#include "sort_network.h"
+#include "set_kernels.h"
+#include "set_view.h"
+#include "presence_bitmap.h"
+#include "flat_hash.h"
+#include "sketches.h"
+#include "sum_index.h"
+#include "sequence_check.h"
+#include "anagram_groups.h"
 #include <string>
 #include <sstream>
 
@@ -168,35 +184,130 @@
 }
 
 - (void)testFindDuplicatesHashing {
-    std::stringstream buffer;
-    std::streambuf* old = std::cout.rdbuf(buffer.rdbuf());
+    auto duplicates = find_duplicates_hashing("hello");
+    XCTAssertEqual(duplicates.size(), 1u);
+    XCTAssertTrue(duplicates[0] == (CharCount{'l', 2}));
+
+    XCTAssertTrue(find_duplicates_hashing("world").empty());
+    auto folded = find_duplicates_hashing("A quick brown Fox jumps over the lazy Dog");
+    std::string letters;
+    for (const auto& entry : folded) letters.push_back(entry.character);
+    XCTAssertEqual(letters, std::string("aeoru")); // 'A' and 'a' count together, spaces do not
+    XCTAssertTrue(folded[2] == (CharCount{'o', 4}));
+}
 
-    find_duplicates_hashing("hello");
-    std::string output = buffer.str();
-    XCTAssertTrue(output.find("'l', Occurences: 2") != std::string::npos);
+- (void)testFindDuplicatesBitwise {
+    auto duplicates = find_duplicates_bitwise("hello");
+    XCTAssertEqual(duplicates.size(), 1u);
+    XCTAssertTrue(duplicates[0] == (CharCount{'l', 2}));
 
-    buffer.str("");
-    find_duplicates_hashing("world");
-    output = buffer.str();
-    XCTAssertTrue(output.find("Duplicates Found: ") != std::string::npos);
-    
-    std::cout.rdbuf(old);
+    XCTAssertTrue(find_duplicates_bitwise("world").empty());
+    std::string text = "A quick brown Fox jumps over the lazy Dog";
+    XCTAssertTrue(find_duplicates_bitwise(text) == find_duplicates_hashing(text));
 }
 
-- (void)testFindDuplicatesBitwise {
-    std::stringstream buffer;
-    std::streambuf* old = std::cout.rdbuf(buffer.rdbuf());
+- (void)testCharacterHistogramsOnLongText {
+    // Long enough for the interleaved tables, with a tail that is not a multiple of 8.
+    std::string text;
+    for (size_t i = 0; i < 5003; ++i) text.push_back(static_cast<char>(i * 131 % 256));
+    ByteHistogram counts = byte_histogram(text.data(), text.size());
+    ByteHistogram expected{};
+    for (char c : text) ++expected[static_cast<unsigned char>(c)];
+    XCTAssertTrue(histograms_equal(counts, expected));
+    ++expected[0];
+    XCTAssertFalse(histograms_equal(counts, expected));
+
+    std::string shuffled = text;
+    std::reverse(shuffled.begin(), shuffled.end());
+    XCTAssertTrue(are_anagrams_hash(text, shuffled));
+    shuffled[10] ^= 1; // moves one count to a neighbouring byte, never a case pair
+    XCTAssertFalse(are_anagrams_hash(text, shuffled));
+    XCTAssertTrue(are_anagrams_bitwise("Listen!", "Silent?")); // only letters are compared
+    XCTAssertFalse(are_anagrams_hash("Listen!", "Silent?"));
+}
 
-    find_duplicates_bitwise("hello");
-    std::string output = buffer.str();
-    XCTAssertTrue(output.find("'l' is a duplicate.") != std::string::npos);
+- (void)testPermutationGeneratorReusesOneBuffer {
+    std::vector<std::string> seen;
+    const char *buffer = nullptr;
+    bool one_buffer = true;
+    for (std::string_view p : PermutationGenerator("abcd")) {
+        if (!buffer) buffer = p.data();
+        one_buffer &= p.data() == buffer;
+        seen.emplace_back(p);
+    }
+    XCTAssertTrue(one_buffer);
+    XCTAssertEqual(seen.size(), 24u);
+    std::vector<std::string> expected = generate_permutations("abcd");
+    std::sort(seen.begin(), seen.end());
+    std::sort(expected.begin(), expected.end());
+    XCTAssertTrue(seen == expected);
+
+    size_t empty = 0, repeated = 0, visited = 0;
+    for_each_permutation("", [&](std::string_view p) { empty += p.empty(); });
+    XCTAssertEqual(empty, 1u);
+    for_each_permutation("aab", [&](std::string_view) { ++repeated; });
+    XCTAssertEqual(repeated, 6u); // positions are distinct, so "aab" appears twice
+    XCTAssertFalse(for_each_permutation("abcdef", [&](std::string_view) { return ++visited < 5; }));
+    XCTAssertEqual(visited, 5u);
+}
 
-    buffer.str("");
-    find_duplicates_bitwise("world");
-    output = buffer.str();
-    XCTAssertTrue(output.find("No duplicate alphabetic characters found.") != std::string::npos);
+- (void)testPermutationRanksAndParallelEnumeration {
+    const std::string s = "abcdef";
+    std::vector<std::string> in_order;
+    for_each_permutation_in_range(s, 0, UINT64_MAX, [&](std::string_view p) { in_order.emplace_back(p); });
+    XCTAssertEqual(in_order.size(), 720u);
+    XCTAssertTrue(std::is_sorted(in_order.begin(), in_order.end())); // sorted distinct input
+    XCTAssertEqual(permutation_at(s, 0), std::string("abcdef"));
+    XCTAssertEqual(permutation_at(s, 719), std::string("fedcba"));
+    for (uint64_t rank : {0u, 1u, 119u, 500u, 719u}) {
+        XCTAssertEqual(permutation_at(s, rank), in_order[rank]);
+        XCTAssertEqual(rank_permutation(unrank_permutation(6, rank)), rank);
+    }
+
+    // Resuming from a rank continues the same sequence.
+    std::vector<std::string> resumed;
+    RankedPermutationGenerator generator(s, 300);
+    do resumed.emplace_back(generator.Current()); while (resumed.size() < 3 && generator.Next());
+    XCTAssertTrue(resumed == std::vector<std::string>(in_order.begin() + 300, in_order.begin() + 303));
+
+    const std::string longer = "abcdefgh"; // 40320 permutations, several rank blocks
+    std::vector<std::vector<std::string>> per_worker(3);
+    XCTAssertTrue(for_each_permutation_parallel(longer, 3, [&](size_t worker, std::string_view p) {
+        per_worker[worker].emplace_back(p);
+    }));
+    std::vector<std::string> merged;
+    for (const auto &part : per_worker) merged.insert(merged.end(), part.begin(), part.end());
+    std::sort(merged.begin(), merged.end());
+    XCTAssertEqual(merged.size(), 40320u);
+    XCTAssertTrue(std::adjacent_find(merged.begin(), merged.end()) == merged.end());
+
+    XCTAssertThrowsSpecific(permutation_count(21), std::length_error);
+    XCTAssertThrowsSpecific(unrank_permutation(3, 6), std::out_of_range);
+    std::vector<size_t> repeated = {0, 0, 1};
+    XCTAssertThrowsSpecific(rank_permutation(repeated), std::invalid_argument);
+}
 
-    std::cout.rdbuf(old);
+- (void)testDistinctPermutationsSkipRepeats {
+    std::vector<std::string> distinct;
+    for_each_distinct_permutation("aabbcc", [&](std::string_view p) { distinct.emplace_back(p); });
+    XCTAssertEqual(distinct.size(), 90u); // 6! / (2! 2! 2!), not 720
+    XCTAssertTrue(std::is_sorted(distinct.begin(), distinct.end()));
+    XCTAssertTrue(std::adjacent_find(distinct.begin(), distinct.end()) == distinct.end());
+    std::vector<std::string> all = generate_permutations("aabbcc");
+    std::sort(all.begin(), all.end());
+    all.erase(std::unique(all.begin(), all.end()), all.end());
+    XCTAssertTrue(all == distinct);
+
+    DistinctPermutationGenerator generator("cab");
+    XCTAssertTrue(generator.Current() == "abc"); // starts from the sorted characters
+    XCTAssertTrue(generator.Next());
+    XCTAssertTrue(generator.Current() == "acb");
+
+    XCTAssertEqual(count_distinct_permutations("aabbcc"), 90u);
+    XCTAssertEqual(count_distinct_permutations("mississippi"), 34650u);
+    XCTAssertEqual(count_distinct_permutations(""), 1u);
+    XCTAssertEqual(count_distinct_permutations("abcdefghijklmnopqrst"), 2432902008176640000u); // 20!
+    XCTAssertThrowsSpecific(count_distinct_permutations("abcdefghijklmnopqrstu"), std::overflow_error);
 }
 
 - (void)testAreAnagramsHash {
@@ -214,6 +325,144 @@
     XCTAssertTrue(are_anagrams_bitwise("hello", "olleh"));
 }
 
+- (void)testUtf8StringFunctionsWorkOnCodePoints {
+    std::string s = "añb😀";
+    reverse_utf8(s);
+    XCTAssertEqual(s, "😀bña");
+    std::string malformed = "a\xC3" "b"; // a lead byte with no continuation stays one character
+    reverse_utf8(malformed);
+    XCTAssertEqual(malformed, "b\xC3" "a");
+
+    // Long ASCII stretches go through the block kernels, the rest by character.
+    std::string ascii(70, 'x');
+    std::string mixed = ascii + "éΣ" + std::string(40, 'y') + "ж";
+    std::string reversed = mixed;
+    reverse_utf8(reversed);
+    XCTAssertEqual(reversed, "ж" + std::string(40, 'y') + "Σé" + ascii);
+    XCTAssertTrue(is_palindrome_utf8(mixed + reversed));
+    XCTAssertTrue(is_palindrome_utf8(mixed + "Ж" + reversed)); // a multi-byte middle character
+    std::string upper = reversed;
+    upper.replace(upper.find("Σé"), std::string("Σé").size(), "σÉ");
+    XCTAssertFalse(is_palindrome_utf8(mixed + upper));
+    XCTAssertTrue(is_palindrome_utf8(mixed + upper, true));
+    XCTAssertTrue(is_palindrome_utf8("été"));
+    XCTAssertFalse(is_palindrome_utf8("Été"));
+    XCTAssertTrue(is_palindrome_utf8("Été", true));
+
+    std::vector<CodePointCount> duplicates = find_duplicates_utf8("Ééa—— Aß!!");
+    std::vector<CodePointCount> expected = {{U'a', 2}, {U'é', 2}, {U'—', 2}};
+    XCTAssertTrue(duplicates == expected);
+
+    XCTAssertTrue(are_anagrams_utf8("Éclat", "talcé"));
+    XCTAssertTrue(are_anagrams_utf8("\u212Aiwi", "kiwi")); // KELVIN SIGN folds to k
+    XCTAssertTrue(are_anagrams_utf8("ΣΟΦΙΑ", "σοφια"));
+    XCTAssertFalse(are_anagrams_utf8("Straße", "STRASSE")); // simple folding keeps ß
+    XCTAssertFalse(are_anagrams_utf8("é", "e"));
+
+    // Folding covers every block, not only the basic alphabets.
+    XCTAssertTrue(is_palindrome_utf8("Șaș", true));                // Latin Extended-B
+    XCTAssertTrue(are_anagrams_utf8("Ơn", "nơ"));                  // Vietnamese
+    XCTAssertTrue(are_anagrams_utf8("\u01C4\u01C5", "\u01C6\u01C6")); // Ǆ ǅ ǆ
+    XCTAssertTrue(are_anagrams_utf8("Ἀ", "ἀ"));                    // Greek Extended
+    XCTAssertTrue((find_duplicates_utf8("ȚțŞ") == std::vector<CodePointCount>{{U'ț', 2}}));
+    XCTAssertEqual(fold_case_simple(0x218), char32_t(0x219));
+    XCTAssertEqual(fold_case_simple(0x1F08), char32_t(0x1F00));
+    XCTAssertEqual(fold_case_simple(0x10400), char32_t(0x10428)); // Deseret
+    XCTAssertEqual(fold_case_simple(0x130), char32_t(0x130));     // İ has no simple fold
+}
+
+- (void)testSubstringSearchMethodsAgree {
+    XCTAssertEqual(find_substring("hello world", "o w"), 4u);
+    XCTAssertEqual(find_substring("hello world", "o", 5), 7u);
+    XCTAssertEqual(find_substring("abc", "abcd"), std::string_view::npos);
+    XCTAssertEqual(find_substring("abc", ""), 0u);
+    XCTAssertEqual(count_substrings("aaaa", "aa"), 3u); // overlapping
+    XCTAssertTrue((find_all_substrings("abababa", "aba") == std::vector<size_t>{0, 2, 4}));
+    XCTAssertEqual(StringSearcher(std::string(100, 'x')).Method(), SearchMethod::TwoWay);
+
+    // Every method, against std::string::find, on periodic patterns and text
+    // long enough for the vector loops and the long-pattern skips.
+    std::string text;
+    for (size_t i = 0; i < 3000; ++i) text.push_back("abab"[(i * i) % 4] + (i % 97 == 0));
+    for (size_t m : {1u, 2u, 3u, 5u, 17u, 40u, 80u, 300u}) {
+        std::string pattern = text.substr(1500, m);
+        std::vector<size_t> expected;
+        for (size_t at = text.find(pattern); at != std::string::npos; at = text.find(pattern, at + 1))
+            expected.push_back(at);
+        for (SearchMethod method : {SearchMethod::Auto, SearchMethod::Filter, SearchMethod::Horspool, SearchMethod::TwoWay}) {
+            StringSearcher searcher(pattern, method);
+            XCTAssertTrue(searcher.FindAll(text) == expected);
+            XCTAssertEqual(searcher.Find(text, 1501), text.find(pattern, 1501));
+        }
+    }
+}
+
+- (void)testAhoCorasickFindsEveryPattern {
+    AhoCorasick dictionary{"he", "she", "his", "hers", "she"};
+    std::vector<PatternMatch> matches = dictionary.FindAll("ushers");
+    // By end position; at one end, longest first, then repeats in dictionary order.
+    std::vector<PatternMatch> expected = {{1, 1}, {4, 1}, {0, 2}, {3, 2}};
+    XCTAssertTrue(matches == expected);
+    XCTAssertEqual(dictionary.Count("she said his hers"), 6u); // she twice, he, his, he, hers
+    XCTAssertTrue(dictionary.ContainsAny("this"));
+    XCTAssertFalse(dictionary.ContainsAny("abc"));
+    XCTAssertThrowsSpecific((AhoCorasick{"a", ""}), std::invalid_argument);
+}
+
+- (void)testAnagramGroupsMatchPairwiseCheck {
+    AnagramGroups groups = AnagramGroups::FromText("listen google Silent\n enlist\telgoog abc\r\nlisten");
+    XCTAssertEqual(groups.WordCount(), 7u);
+    XCTAssertEqual(groups.GroupCount(), 3u); // numbered by first word, words in input order
+    std::vector<std::string_view> first(groups.Group(0).begin(), groups.Group(0).end());
+    XCTAssertTrue((first == std::vector<std::string_view>{"listen", "Silent", "enlist", "listen"}));
+    XCTAssertEqual(groups.Group(1).size(), 2u);
+    XCTAssertThrowsSpecific(groups.Group(3), std::out_of_range);
+    std::ostringstream out;
+    groups.Write(out); // groups of two or more
+    XCTAssertEqual(out.str(), "listen Silent enlist listen\ngoogle elgoog\n");
+
+    // Past 16 bytes, and with non-letters, the signature matches are_anagrams_hash.
+    std::vector<std::string> words = {"Dormitory dirty room", "dirty room dormitory", "abcdefghijklmnopqr",
+                                      "rqponmlkjihgfedcba", "ab-c", "c-ba", "abc", "\xC3\xA9t\xC3\xA9", "t\xC3\xA9\xC3\xA9"};
+    AnagramGroups listed = AnagramGroups::FromWords(words);
+    listed.ForEachGroup([&](std::span<const std::string_view> group) {
+        for (std::string_view word : group)
+            XCTAssertTrue(are_anagrams_hash(std::string(group[0]), std::string(word)));
+    });
+    XCTAssertEqual(listed.GroupCount(), 5u);
+
+    // The grouping does not depend on the thread count.
+    std::string text;
+    for (size_t i = 0; i < 50000; ++i)
+        text += words[(i * 7) % words.size()].substr(0, 4 + i % 5) + (i % 3 ? " " : "\n");
+    std::ostringstream one, many;
+    AnagramGroups::FromText(text, 1).Write(one, 1);
+    AnagramGroups::FromText(text, 4).Write(many, 1);
+    XCTAssertEqual(one.str(), many.str());
+}
+
+- (void)testReverseAndPalindromeOnLongBuffers {
+    // Lengths around the 16- and 32-byte block sizes exercise every tail.
+    for (size_t n : {15u, 16u, 31u, 32u, 33u, 63u, 64u, 65u, 127u, 1000u}) {
+        std::string s;
+        for (size_t i = 0; i < n; ++i) s.push_back(static_cast<char>('a' + (i * 7) % 26));
+        std::string expected(s.rbegin(), s.rend());
+        reverse_string(s);
+        XCTAssertEqual(s, expected);
+
+        std::string palindrome = s + std::string(s.rbegin(), s.rend());
+        XCTAssertTrue(is_palindrome(palindrome));
+        palindrome[n / 3] = '#';
+        XCTAssertFalse(is_palindrome(palindrome));
+    }
+    std::string mixed = "Step on no pets, STEP ON NO PETS";
+    std::string shouted = std::string(40, 'x') + "AbBa" + std::string(40, 'X');
+    XCTAssertFalse(is_palindrome(shouted));
+    XCTAssertTrue(is_palindrome(shouted, true));
+    XCTAssertFalse(is_palindrome(mixed, true)); // ',' and ' ' are not skipped
+    XCTAssertFalse(is_palindrome(std::string(40, '@') + std::string(40, '`'), true)); // not letters
+}
+
 @end
 
 @interface ArrayComprehensiveTests : XCTestCase
@@ -460,4 +709,836 @@
     XCTAssertEqual(arr3.Get(0).value(), 30);
 }
 
+- (void)testNthElementIntroselect {
+    Array<int> arr;
+    int values[] = {9, 1, 8, 2, 7, 3, 6, 4, 5, 5};
+    for (int v : values) arr.Append(v);
+
+    XCTAssertEqual(arr.NthElement(4), 5);
+    for (size_t i = 0; i < 4; ++i) XCTAssertLessThanOrEqual(arr.Get(i).value(), 5);
+    for (size_t i = 5; i < arr.GetLength(); ++i) XCTAssertGreaterThanOrEqual(arr.Get(i).value(), 5);
+
+    XCTAssertThrowsSpecific(arr.NthElement(10), std::out_of_range);
+}
+
+- (void)testNthElementFloydRivestLargeInput {
+    Array<int> arr;
+    for (int i = 0; i < 5000; ++i) arr.Append((i * 7919) % 5000); // permutation of 0..4999
+
+    XCTAssertEqual(arr.NthElement(2500, SelectAlgorithm::FloydRivest), 2500);
+    XCTAssertEqual(arr.NthElement(0, SelectAlgorithm::FloydRivest), 0);
+    XCTAssertEqual(arr.NthElement(4999, SelectAlgorithm::FloydRivest), 4999);
+}
+
+- (void)testTopK {
+    Array<int> arr;
+    int values[] = {4, 10, 3, 7, 10, 1};
+    for (int v : values) arr.Append(v);
+
+    Array<int> top = arr.TopK(3);
+
+    XCTAssertEqual(top.GetLength(), 3);
+    XCTAssertEqual(top.Get(0).value(), 10);
+    XCTAssertEqual(top.Get(1).value(), 10);
+    XCTAssertEqual(top.Get(2).value(), 7);
+    XCTAssertEqual(arr.Get(0).value(), 4); // source is untouched
+    XCTAssertEqual(arr.TopK(100).GetLength(), 6);
+}
+
+- (void)testPartialSort {
+    Array<int> arr;
+    int values[] = {50, 20, 40, 10, 30, 60};
+    for (int v : values) arr.Append(v);
+
+    arr.PartialSort(3);
+
+    XCTAssertEqual(arr.Get(0).value(), 10);
+    XCTAssertEqual(arr.Get(1).value(), 20);
+    XCTAssertEqual(arr.Get(2).value(), 30);
+
+    arr.PartialSort(arr.GetLength());
+    XCTAssertTrue(arr.isSorted());
+}
+
+- (void)testSortSmallArrayUsesNetwork {
+    Array<int> arr;
+    for (int i = 0; i < 37; ++i) arr.Append((i * 17) % 37 - 18);
+
+    arr.Sort();
+
+    XCTAssertTrue(arr.isSorted());
+    XCTAssertEqual(arr.GetLength(), 37);
+    XCTAssertEqual(arr.Get(0).value(), -18);
+    XCTAssertEqual(arr.Get(36).value(), 18);
+}
+
+- (void)testSortLargeArrayWithDuplicates {
+    Array<long long> arr;
+    for (long long i = 0; i < 10000; ++i) arr.Append((i * 7919) % 101);
+
+    arr.Sort();
+
+    XCTAssertTrue(arr.isSorted());
+    XCTAssertEqual(arr.GetLength(), 10000);
+}
+
+- (void)testSortNetworkKernels {
+    int32_t ints[13] = {5, -1, 9, 3, 3, 0, 12, -7, 8, 2, 1, 11, 4};
+    sort_network(ints, 13);
+    XCTAssertTrue(std::is_sorted(ints, ints + 13));
+
+    float floats[64];
+    for (int i = 0; i < 64; ++i) floats[i] = static_cast<float>(63 - i) * 0.5f;
+    sort_network_fixed<64>(floats);
+    for (int i = 0; i < 64; ++i) XCTAssertEqual(floats[i], static_cast<float>(i) * 0.5f);
+
+    int64_t wide[8] = {1LL << 40, -(1LL << 40), 3, 2, 1, 0, -1, 7};
+    sort_network_fixed<8>(wide);
+    XCTAssertTrue(std::is_sorted(wide, wide + 8));
+    XCTAssertEqual(wide[0], -(1LL << 40));
+
+    int32_t too_many[65] = {};
+    XCTAssertThrowsSpecific(sort_network(too_many, 65), std::length_error);
+}
+
+- (void)testGallopingIntersectionMatchesLinear {
+    Array<int> small;
+    small.Append(3);
+    small.Append(500);
+    small.Append(500);
+    small.Append(999);
+    small.Append(5000);
+
+    Array<int> large;
+    for (int i = 0; i < 1000; ++i) large.Append(i);
+    large.Append(999); // duplicate in the large side
+
+    Array<int> linear = small.Intersection(large, SetStrategy::Linear);
+    Array<int> galloping = small.Intersection(large, SetStrategy::Galloping);
+    Array<int> automatic = large.Intersection(small); // ratio triggers galloping
+
+    XCTAssertEqual(linear.GetLength(), 3);
+    XCTAssertEqual(galloping.GetLength(), linear.GetLength());
+    XCTAssertEqual(automatic.GetLength(), linear.GetLength());
+    for (size_t i = 0; i < linear.GetLength(); ++i) {
+        XCTAssertEqual(galloping.Get(i).value(), linear.Get(i).value());
+        XCTAssertEqual(automatic.Get(i).value(), linear.Get(i).value());
+    }
+}
+
+- (void)testGallopingDifferenceMatchesLinear {
+    Array<int> small;
+    small.Append(-1);
+    small.Append(10);
+    small.Append(10);
+    small.Append(2000);
+
+    Array<int> large;
+    for (int i = 0; i < 1000; ++i) large.Append(i);
+
+    Array<int> largeMinusSmall = large.Difference(small, SetStrategy::Galloping);
+    XCTAssertEqual(largeMinusSmall.GetLength(), 999);
+    XCTAssertFalse(largeMinusSmall.BinarySearchLoop(10).has_value());
+
+    Array<int> smallMinusLarge = small.Difference(large); // auto -> galloping
+    Array<int> expected = small.Difference(large, SetStrategy::Linear);
+    XCTAssertEqual(smallMinusLarge.GetLength(), 3);
+    XCTAssertEqual(smallMinusLarge.GetLength(), expected.GetLength());
+    XCTAssertEqual(smallMinusLarge.Get(0).value(), -1);
+    XCTAssertEqual(smallMinusLarge.Get(1).value(), 10); // one copy of 10 survives
+    XCTAssertEqual(smallMinusLarge.Get(2).value(), 2000);
+}
+
+- (void)testVectorizedSetOpsMatchLinearOnUniqueSets {
+    Array<int> a, b;
+    for (int i = 0; i < 300; ++i) a.Append(i * 3);      // multiples of 3
+    for (int i = 0; i < 200; ++i) b.Append(i * 5 - 7);  // shifted multiples of 5
+
+    Array<int> linear = a.Intersection(b, SetStrategy::Linear);
+    Array<int> vectorized = a.Intersection(b, SetStrategy::Vectorized);
+    XCTAssertEqual(vectorized.GetLength(), linear.GetLength());
+    for (size_t i = 0; i < linear.GetLength(); ++i)
+        XCTAssertEqual(vectorized.Get(i).value(), linear.Get(i).value());
+
+    Array<int> diffLinear = a.Difference(b, SetStrategy::Linear);
+    Array<int> diffVectorized = a.Difference(b, SetStrategy::Vectorized);
+    XCTAssertEqual(diffVectorized.GetLength(), diffLinear.GetLength());
+    for (size_t i = 0; i < diffLinear.GetLength(); ++i)
+        XCTAssertEqual(diffVectorized.Get(i).value(), diffLinear.Get(i).value());
+
+    Array<int> unionVectorized = a.Union(b, SetStrategy::Vectorized);
+    XCTAssertEqual(unionVectorized.GetLength(), a.Union(b, SetStrategy::Linear).GetLength());
+    XCTAssertTrue(unionVectorized.isSorted());
+}
+
+- (void)testVectorizedSetOpsKeepDuplicateSemantics {
+    // Duplicates rule out the SIMD block compare; the branch-free merge must
+    // still match the two-pointer loop exactly.
+    Array<unsigned int> a, b;
+    unsigned int av[] = {1, 1, 2, 5, 5, 5, 9, 12, 12, 13, 20};
+    unsigned int bv[] = {1, 5, 5, 12, 14, 20, 20};
+    for (unsigned int v : av) a.Append(v);
+    for (unsigned int v : bv) b.Append(v);
+
+    Array<unsigned int> inter = a.Intersection(b, SetStrategy::Vectorized);
+    XCTAssertEqual(inter.GetLength(), 5); // 1, 5, 5, 12, 20
+    XCTAssertEqual(inter.Get(1).value(), 5u);
+
+    Array<unsigned int> diff = a.Difference(b, SetStrategy::Vectorized);
+    XCTAssertEqual(diff.GetLength(), 6); // 1, 2, 5, 9, 12, 13
+
+    Array<unsigned int> uni = a.Union(b, SetStrategy::Vectorized);
+    XCTAssertEqual(uni.GetLength(), a.Union(b, SetStrategy::Linear).GetLength());
+}
+
+- (void)testSetOpsIntoCallerBuffers {
+    Array<int> a, b;
+    int av[] = {1, 3, 5, 7, 9, 11};
+    int bv[] = {3, 4, 5, 11, 12};
+    for (int v : av) a.Append(v);
+    for (int v : bv) b.Append(v);
+
+    // Reused Array: the count matches the allocating overload.
+    Array<int> out;
+    XCTAssertEqual(a.Intersection(b, out), 3); // 3, 5, 11
+    XCTAssertEqual(out.GetLength(), 3);
+    XCTAssertEqual(out.Get(2).value(), 11);
+    XCTAssertEqual(a.Union(b, out), 8);
+    XCTAssertEqual(out.GetLength(), a.Union(b).GetLength());
+
+    // Span: exact fit works, a short span throws.
+    int exact[3];
+    XCTAssertEqual(a.Difference(b, std::span<int>(exact)), 3); // 1, 7, 9
+    XCTAssertEqual(exact[1], 7);
+    int tooSmall[2];
+    XCTAssertThrowsSpecific(a.Difference(b, std::span<int>(tooSmall)), std::length_error);
+
+    // Output iterator.
+    std::vector<int> merged;
+    XCTAssertEqual(a.Merge(b, std::back_inserter(merged)), 11);
+    XCTAssertTrue(std::is_sorted(merged.begin(), merged.end()));
+
+    // Writing over an input still gives the right answer.
+    Array<int> self = a;
+    XCTAssertEqual(self.Intersection(b, self), 3);
+    XCTAssertEqual(self.Get(0).value(), 3);
+}
+
+- (void)testMergeWithMatchesMerge {
+    Array<int> a, b;
+    int av[] = {1, 4, 4, 8};
+    int bv[] = {0, 4, 9, 10};
+    for (int v : av) a.Append(v);
+    for (int v : bv) b.Append(v);
+    Array<int> expected = a.Merge(b);
+
+    a.MergeWith(b);
+    XCTAssertEqual(a.GetLength(), expected.GetLength());
+    for (size_t i = 0; i < expected.GetLength(); ++i)
+        XCTAssertEqual(a.Get(i).value(), expected.Get(i).value());
+
+    a.MergeWith(a); // self-merge doubles every value
+    XCTAssertEqual(a.GetLength(), 16);
+    XCTAssertTrue(a.isSorted());
+}
+
+- (void)testLoserTreeMergesStably {
+    int a[] = {1, 4, 4, 9};
+    int b[] = {2, 4};
+    int c[] = {0, 10};
+    std::vector<LoserTree<int>::Range> sources = {{a, a + 4}, {b, b + 2}, {nullptr, nullptr}, {c, c + 2}};
+    LoserTree<int> tree(sources);
+    std::vector<int> values;
+    std::vector<size_t> from;
+    for (; !tree.Empty(); tree.Pop()) {
+        values.push_back(tree.Top());
+        from.push_back(tree.TopSource());
+    }
+    std::vector<int> expected = {0, 1, 2, 4, 4, 4, 9, 10};
+    XCTAssertTrue(values == expected);
+    // The three 4s come out in source order: a, a, b.
+    XCTAssertEqual(from[3], 0);
+    XCTAssertEqual(from[4], 0);
+    XCTAssertEqual(from[5], 1);
+}
+
+- (void)testKWaySetOpsMatchChainedPairwise {
+    std::vector<Array<int>> lists(5);
+    for (int i = 0; i < 60; ++i) {
+        lists[0].Append(i);         // 0..59
+        if (i % 2 == 0) lists[1].Append(i);
+        if (i % 3 == 0) lists[2].Append(i);
+        lists[3].Append(i);         // every value twice
+        lists[3].Append(i);
+        if (i % 5 == 0) lists[4].Append(i);
+    }
+
+    Array<int> merged = lists[0], united = lists[0], common = lists[0];
+    for (size_t i = 1; i < lists.size(); ++i) {
+        merged = merged.Merge(lists[i]);
+        united = united.Union(lists[i]);
+        common = common.Intersection(lists[i]);
+    }
+
+    Array<int> mergeAll = Array<int>::MergeAll(lists);
+    Array<int> unionAll = Array<int>::UnionAll(lists);
+    Array<int> intersectAll = Array<int>::IntersectAll(lists);
+    XCTAssertEqual(mergeAll.GetLength(), merged.GetLength());
+    XCTAssertEqual(unionAll.GetLength(), united.GetLength());
+    XCTAssertEqual(intersectAll.GetLength(), common.GetLength());
+    for (size_t i = 0; i < merged.GetLength(); ++i)
+        XCTAssertEqual(mergeAll.Get(i).value(), merged.Get(i).value());
+    for (size_t i = 0; i < united.GetLength(); ++i)
+        XCTAssertEqual(unionAll.Get(i).value(), united.Get(i).value());
+    for (size_t i = 0; i < common.GetLength(); ++i)
+        XCTAssertEqual(intersectAll.Get(i).value(), common.Get(i).value());
+    XCTAssertEqual(intersectAll.Get(1).value(), 30); // multiples of 30 below 60
+
+    lists.push_back(Array<int>());
+    XCTAssertEqual(Array<int>::IntersectAll(lists).GetLength(), 0);
+    XCTAssertEqual(Array<int>::MergeAll(std::span<const Array<int>>()).GetLength(), 0);
+}
+
+- (void)testMergePathValueSplitKeepsRunsTogether {
+    int a[] = {1, 3, 3, 3, 8};
+    int b[] = {3, 3, 9};
+    // Diagonal 3 of the merge 1 3 3 | 3 3 3 8 9 falls inside the run of 3s.
+    auto plain = merge_path_split(a, 5, b, 3, 3);
+    XCTAssertEqual(plain.first, 3);
+    XCTAssertEqual(plain.second, 0);
+    auto aligned = merge_path_value_split(a, 5, b, 3, 3);
+    XCTAssertEqual(aligned.first, 1); // cut moved back to the first 3
+    XCTAssertEqual(aligned.second, 0);
+}
+
+- (void)testParallelSetOpsMatchSerial {
+    Array<int> a, b;
+    for (int i = 0; i < 400000; ++i) a.Append(i / 3);       // runs of three
+    for (int i = 0; i < 300000; ++i) b.Append(i * 7 / 10);  // runs of one or two
+
+    auto same = [](const Array<int> &x, const Array<int> &y) {
+        return x.GetLength() == y.GetLength() && std::equal(x.begin(), x.end(), y.begin());
+    };
+    XCTAssertTrue(same(a.ParallelMerge(b, 4), a.Merge(b)));
+    XCTAssertTrue(same(a.ParallelUnion(b, 4), a.Union(b)));
+    XCTAssertTrue(same(a.ParallelIntersection(b, 4), a.Intersection(b)));
+    XCTAssertTrue(same(a.ParallelDifference(b, 4), a.Difference(b)));
+    XCTAssertTrue(same(b.ParallelDifference(a, 3), b.Difference(a)));
+
+    // Interleaved unique sets take the vectorized kernels, which write past
+    // their result; slices must not overwrite their neighbours.
+    Array<int> c, d;
+    unsigned state = 12345;
+    for (int v = 0; v < 2000000; ++v) {
+        state = state * 1103515245u + 12345u;
+        if (state >> 30 == 0) c.Append(v);
+        else if (state >> 30 == 1) d.Append(v);
+        else if (state >> 30 == 2) { c.Append(v); d.Append(v); }
+    }
+    for (size_t threads : {2u, 5u, 8u}) {
+        XCTAssertTrue(same(c.ParallelUnion(d, threads), c.Union(d)));
+        XCTAssertTrue(same(c.ParallelIntersection(d, threads), c.Intersection(d)));
+        XCTAssertTrue(same(c.ParallelDifference(d, threads), c.Difference(d)));
+    }
+}
+
+- (void)testRoaringSetRoundTripAndMembership {
+    Array<int> ids;
+    for (int i = 0; i < 10; ++i) ids.Append(i * 1000);         // sparse block
+    for (int i = 70000; i < 80000; ++i) ids.Append(i);          // one long run
+    for (int i = 140000; i < 190000; i += 2) ids.Append(i);     // dense, no runs
+    ids.Append(70000); // duplicates are ignored
+
+    RoaringSet set = RoaringSet::FromArray(ids);
+    XCTAssertEqual(set.Cardinality(), 10 + 10000 + 25000);
+    XCTAssertTrue(set.Contains(3000));
+    XCTAssertTrue(set.Contains(75000));
+    XCTAssertFalse(set.Contains(80000));
+    XCTAssertTrue(set.Contains(140002));
+    XCTAssertFalse(set.Contains(140003));
+    XCTAssertTrue(set.SizeInBytes() < ids.GetLength() * sizeof(int) / 5);
+
+    Array<int> back = set.ToArray<int>();
+    XCTAssertEqual(back.GetLength(), set.Cardinality());
+    XCTAssertTrue(back.isSorted());
+    XCTAssertEqual(back.Get(10).value(), 70000);
+
+    Array<int> negative;
+    negative.Append(-5);
+    XCTAssertThrowsSpecific(RoaringSet::FromArray(negative), std::out_of_range);
+}
+
+- (void)testRoaringSetOperationsMatchArray {
+    Array<int> a, b;
+    for (int i = 0; i < 200000; ++i) {
+        if (i % 3 == 0) a.Append(i);             // bitmap blocks
+        if ((i / 1000) % 2 == 0) b.Append(i);    // run blocks
+    }
+    for (int i = 300000; i < 300100; ++i) a.Append(i * 7); // array blocks
+    RoaringSet ra = RoaringSet::FromArray(a), rb = RoaringSet::FromArray(b);
+
+    auto same = [](const Array<int> &x, const Array<int> &y) {
+        return x.GetLength() == y.GetLength() && std::equal(x.begin(), x.end(), y.begin());
+    };
+    XCTAssertTrue(same(ra.Union(rb).ToArray<int>(), a.Union(b)));
+    XCTAssertTrue(same(ra.Intersection(rb).ToArray<int>(), a.Intersection(b)));
+    XCTAssertTrue(same(ra.Difference(rb).ToArray<int>(), a.Difference(b)));
+    XCTAssertTrue(same(rb.Difference(ra).ToArray<int>(), b.Difference(a)));
+    XCTAssertEqual(ra.Intersection(rb).Cardinality(), a.Intersection(b).GetLength());
+
+    RoaringSet grown = rb;
+    grown.Add(1500);  // fills a gap between runs
+    grown.Add(1500);  // already present
+    XCTAssertEqual(grown.Cardinality(), rb.Cardinality() + 1);
+    XCTAssertTrue(grown.Contains(1500));
+}
+
+- (void)testSetViewsMatchChainedOps {
+    Array<int> a, b, c, d;
+    for (int i = 0; i < 3000; ++i) {
+        if (i % 2 == 0) a.Append(i);
+        if (i % 3 == 0) b.Append(i);
+        if (i % 5 == 0) c.Append(i);
+        if (i % 7 == 0) d.Append(i);
+    }
+    a.Append(3000); a.Append(3000); b.Append(3000); // duplicates
+    c.Append(3000); c.Append(3000);
+
+    auto same = [](const Array<int> &x, const Array<int> &y) {
+        return x.GetLength() == y.GetLength() && std::equal(x.begin(), x.end(), y.begin());
+    };
+    auto expr = SetDiff(SetIntersect(SetUnion(a, b), c), d);
+    Array<int> materialized = expr.ToArray();
+    XCTAssertTrue(same(materialized, a.Union(b).Intersection(c).Difference(d)));
+    XCTAssertEqual(materialized.GetSize(), materialized.GetLength()); // allocated once, exactly
+    XCTAssertEqual(expr.Count(), a.Union(b).Intersection(c).Difference(d).GetLength());
+    XCTAssertTrue(same(SetUnion(a, SetDiff(c, d)).ToArray(), a.Union(c.Difference(d))));
+
+    Array<int> streamed;
+    for (int v : SetIntersect(a, b)) streamed.Append(v);
+    XCTAssertTrue(same(streamed, a.Intersection(b)));
+}
+
+- (void)testSetViewEmptyAndEarlyStop {
+    Array<int> evens, odds;
+    for (int i = 0; i < 1000; ++i) (i % 2 ? odds : evens).Append(i);
+    XCTAssertTrue(SetIntersect(evens, odds).Empty());
+    XCTAssertFalse(SetDiff(evens, odds).Empty());
+
+    int seen = 0;
+    SetUnion(evens, odds).ForEach([&](int) { return ++seen < 10; });
+    XCTAssertEqual(seen, 10);
+}
+
+- (void)testMissingElementFindersReportRanges {
+    Array<int> arr;
+    for (int v : {10, 1, 2, 2, 6, 14}) arr.Append(v);
+    std::vector<MissingRange<int>> expected = {{3, 6}, {7, 10}, {11, 14}};
+    XCTAssertTrue(arr.FindMultipleMissingElementsHash() == expected);
+    arr.Sort();
+    XCTAssertTrue(arr.FindMultipleMissingElementsSorted() == expected);
+
+    std::vector<MissingRange<int>> buffer(2);
+    XCTAssertThrowsSpecific(arr.FindMultipleMissingElementsSorted(std::span(buffer)),
+                            std::length_error);
+    buffer.resize(3);
+    XCTAssertEqual(arr.FindMultipleMissingElementsHash(std::span(buffer)), 3u);
+
+    int calls = 0;
+    arr.FindMultipleMissingElementsSorted([&](const MissingRange<int> &) { return ++calls < 2; });
+    XCTAssertEqual(calls, 2); // returning false stops the scan
+
+    Array<int> full;
+    for (int v : {3, 4, 5, 5}) full.Append(v);
+    XCTAssertTrue(full.FindMultipleMissingElementsHash().empty());
+    XCTAssertTrue(Array<int>().FindMultipleMissingElementsSorted().empty());
+}
+
+- (void)testDuplicateFindersReportRuns {
+    Array<int> arr;
+    for (int v : {7, 0, 3, 7, 0, 7, 5}) arr.Append(v);
+    std::vector<DuplicateRun<int>> first_seen = {{7, 3}, {0, 2}};
+    XCTAssertTrue(arr.FindDuplicatesHashing() == first_seen);
+    arr.Sort();
+    std::vector<DuplicateRun<int>> in_order = {{0, 2}, {7, 3}};
+    XCTAssertTrue(arr.FindDuplicatesSorted() == in_order);
+
+    std::vector<DuplicateRun<int>> buffer(4);
+    XCTAssertEqual(arr.FindDuplicatesSorted(std::span(buffer)), 2u);
+    XCTAssertTrue(buffer[1] == (DuplicateRun<int>{7, 3}));
+
+    size_t total = 0;
+    arr.FindDuplicatesHashing([&](const DuplicateRun<int> &run) { total += run.count; });
+    XCTAssertEqual(total, 5u);
+}
+
+- (void)testMissingHashSpansBitmapWindows {
+    // A range several kPresenceChunkBits windows wide, with gaps that cross
+    // window boundaries.
+    const long long window = static_cast<long long>(kPresenceChunkBits);
+    Array<long long> arr;
+    for (long long v : {3 * window + 7, -5LL, window - 6, 0LL, window + 2, 3 * window + 8})
+        arr.Append(v);
+    std::vector<MissingRange<long long>> expected = {
+        {-4, 0}, {1, window - 6}, {window - 5, window + 2}, {window + 3, 3 * window + 7}};
+    XCTAssertTrue(arr.FindMultipleMissingElementsHash() == expected);
+    XCTAssertTrue(arr.FindMultipleMissingElementsHash(4) == expected);
+}
+
+- (void)testPresenceBitmapClearRuns {
+    std::vector<uint64_t> words(presence_words(201));
+    uint32_t values[] = {0, 63, 64, 200, 500}; // 500 is outside the window
+    mark_present(values, 5, 0u, 201, words.data());
+    std::vector<std::pair<uint64_t, uint64_t>> runs;
+    for_each_clear_run(words.data(), 201, [&](uint64_t lo, uint64_t hi) { runs.push_back({lo, hi}); });
+    std::vector<std::pair<uint64_t, uint64_t>> expected = {{1, 63}, {65, 200}};
+    XCTAssertTrue(runs == expected);
+}
+
+- (void)testFlatHashMapCountsAndGrows {
+    FlatHashMap<int, int> counts; // starts small and has to rehash
+    for (int i = 0; i < 10000; ++i) counts[i % 1234] += 1;
+    XCTAssertEqual(counts.Size(), 1234u);
+    XCTAssertEqual(*counts.Find(0), 9);
+    XCTAssertEqual(*counts.Find(1233), 8);
+    XCTAssertTrue(counts.Find(1234) == nullptr);
+    XCTAssertFalse(counts.Insert(5, 100));
+    XCTAssertTrue(counts.Insert(-5, 100));
+    XCTAssertEqual(*counts.Find(-5), 100);
+
+    long total = 0;
+    counts.ForEach([&](int, int count) { total += count; });
+    XCTAssertEqual(total, 10000 + 100);
+}
+
+- (void)testFlatHashMapUpdateAtLoadLimitDoesNotGrow {
+    FlatHashMap<int, int> full; // 16 slots, at most 12 keys
+    for (int i = 0; i < 12; ++i) full[i] = i;
+    XCTAssertEqual(full.Capacity(), 16u);
+    for (int i = 0; i < 12; ++i) full[i] += 1;
+    XCTAssertFalse(full.Insert(3, 0));
+    XCTAssertEqual(full.Capacity(), 16u);
+    full[12] = 12; // a thirteenth key does
+    XCTAssertEqual(full.Capacity(), 32u);
+    XCTAssertEqual(full.Size(), 13u);
+    for (int i = 0; i < 12; ++i) XCTAssertEqual(*full.Find(i), i + 1);
+    XCTAssertEqual(*full.Find(12), 12);
+}
+
+- (void)testFlatHashSetSizedUpFront {
+    FlatHashSet<std::string> words(1000);
+    size_t capacity = words.Capacity();
+    XCTAssertTrue(capacity >= 1000 && (capacity & (capacity - 1)) == 0);
+    for (int i = 0; i < 1000; ++i) XCTAssertTrue(words.Insert(std::to_string(i)));
+    XCTAssertEqual(words.Capacity(), capacity); // no rehash needed
+    XCTAssertFalse(words.Insert("42"));
+    XCTAssertTrue(words.Contains("999"));
+    XCTAssertFalse(words.Contains("1000"));
+    words.Clear();
+    XCTAssertTrue(words.Empty());
+    XCTAssertFalse(words.Contains("42"));
+}
+
+- (void)testFlatHashMapEraseKeepsProbeChains {
+    FlatHashMap<int, int> map; // 12 keys in 16 slots: long probe runs
+    for (int i = 0; i < 12; ++i) map[i * 16] = i;
+    XCTAssertTrue(map.Erase(0));
+    XCTAssertFalse(map.Erase(0));
+    XCTAssertTrue(map.Erase(80));
+    XCTAssertEqual(map.Size(), 10u);
+    for (int i = 1; i < 12; ++i) {
+        if (i == 5) continue;
+        XCTAssertTrue(map.Find(i * 16) != nullptr);
+        XCTAssertEqual(*map.Find(i * 16), i);
+    }
+    map[80] = 50; // reuses a freed slot
+    XCTAssertEqual(*map.Find(80), 50);
+}
+
+- (void)testParallelDuplicateCountsMatchSerial {
+    // Enough values to be split into many hash partitions.
+    Array<int> arr;
+    for (long long i = 0; i < 400000; ++i) arr.Append(static_cast<int>(i * 7919 % 150001));
+
+    auto serial = arr.FindDuplicatesHashing();
+    auto parallel = arr.ParallelFindDuplicates(4);
+    XCTAssertEqual(parallel.size(), serial.size());
+    XCTAssertTrue(parallel == arr.ParallelFindDuplicates(1)); // same order for any thread count
+
+    auto by_value = [](const DuplicateRun<int> &x, const DuplicateRun<int> &y) { return x.value < y.value; };
+    std::sort(serial.begin(), serial.end(), by_value);
+    std::sort(parallel.begin(), parallel.end(), by_value);
+    XCTAssertTrue(parallel == serial);
+
+    auto frequencies = arr.ParallelCountFrequencies(3);
+    XCTAssertEqual(frequencies.size(), 150001u);
+    size_t total = 0;
+    for (const auto &run : frequencies) total += run.count;
+    XCTAssertEqual(total, arr.GetLength());
+}
+
+- (void)testSketchesEstimateAndMerge {
+    Array<int> arr;
+    for (int i = 0; i < 200000; ++i) arr.Append(i % 50000);
+
+    auto distinct = HyperLogLog<int>::FromArray(arr);
+    XCTAssertEqualWithAccuracy(distinct.Estimate(), 50000.0, 50000 * 4 * distinct.StandardError());
+    HyperLogLog<int> low, high; // shards of one stream
+    for (int i = 0; i < 50000; ++i) (i < 25000 ? low : high).Append(i);
+    low.Merge(high);
+    XCTAssertEqualWithAccuracy(low.Estimate(), distinct.Estimate(), 1e-9);
+    XCTAssertThrowsSpecific(low.Merge(HyperLogLog<int>(10)), std::invalid_argument);
+
+    auto counts = CountMinSketch<int>::WithErrorBounds(0.001, 0.01);
+    for (int v : arr) counts.Append(v);
+    counts.Append(7, 1000);
+    XCTAssertEqual(counts.TotalCount(), 201000u);
+    XCTAssertTrue(counts.Estimate(7) >= 1004u); // never an underestimate
+    XCTAssertTrue(counts.Estimate(7) <= 1004u + 201);
+    CountMinSketch<int> other(counts.Width(), counts.Depth());
+    other.Append(7, 6);
+    counts.Merge(other);
+    XCTAssertTrue(counts.Estimate(7) >= 1010u);
+
+    auto seen = BloomFilter<int>::FromArray(arr, 0.01);
+    bool all_found = true;
+    for (int v : arr) all_found = all_found && seen.MayContain(v);
+    XCTAssertTrue(all_found); // no false negatives
+    int false_positives = 0;
+    for (int v = 50000; v < 150000; ++v) false_positives += seen.MayContain(v);
+    XCTAssertTrue(false_positives < 2000);
+}
+
+- (void)testSpaceSavingFindsHeavyHitters {
+    // Values 0..4 make up half the stream; the rest occur once each.
+    Array<int> arr;
+    for (int i = 0; i < 100000; ++i) arr.Append(i % 2 == 0 ? (i / 2) % 5 : 1000 + i);
+
+    auto summary = SpaceSaving<int>::FromArray(arr, 50);
+    auto top = summary.TopK(5);
+    XCTAssertEqual(top.size(), 5u);
+    for (const auto &c : top) {
+        XCTAssertTrue(c.value >= 0 && c.value < 5);
+        XCTAssertTrue(c.count - c.error <= 10000u && c.count >= 10000u);
+    }
+
+    SpaceSaving<int> first(50), second(50);
+    int i = 0;
+    for (int v : arr) (i++ < 30000 ? first : second).Append(v);
+    first.Merge(second);
+    XCTAssertEqual(first.TotalCount(), 100000u);
+    for (const auto &c : first.TopK(5)) {
+        XCTAssertTrue(c.value >= 0 && c.value < 5);
+        XCTAssertTrue(c.count - c.error <= 10000u && c.count >= 10000u);
+    }
+    XCTAssertThrowsSpecific(first.Merge(SpaceSaving<int>(10)), std::invalid_argument);
+}
+
+- (void)testQueryDispatchPicksPlanAndMatchesFixedMethods {
+    Array<int> dense; // small range: tables indexed by value
+    for (int i = 0; i < 1000; ++i) dense.Append((i * 37) % 700);
+    XCTAssertTrue(dense.PlanFindDuplicates() == QueryPlan::DirectAddress);
+    XCTAssertTrue(dense.PlanFindMissing() == QueryPlan::DirectAddress);
+    XCTAssertTrue(dense.PlanPairWithSum() == QueryPlan::DirectAddress);
+
+    Array<int> sorted = dense;
+    sorted.Sort();
+    XCTAssertTrue(sorted.PlanFindDuplicates() == QueryPlan::SortedScan);
+    XCTAssertTrue(sorted.PlanPairWithSum() == QueryPlan::SortedScan);
+
+    Array<int> sparse; // range far wider than the length
+    for (int i = 0; i < 1000; ++i) sparse.Append((i * 7919) % 1000 * 2000003);
+    XCTAssertTrue(sparse.PlanFindDuplicates() == QueryPlan::Hashing);
+    XCTAssertTrue(sparse.PlanFindMissing() == QueryPlan::SortedCopy);
+    XCTAssertTrue(sparse.PlanPairWithSum() == QueryPlan::Hashing);
+
+    Array<int> tiny;
+    for (int v : {3, 1, 3, 2}) tiny.Append(v);
+    XCTAssertTrue(tiny.PlanFindDuplicates() == QueryPlan::BruteForce);
+
+    // Every plan gives the same answer, in value order.
+    auto expected = sorted.FindDuplicatesSorted();
+    for (QueryPlan plan : {QueryPlan::Auto, QueryPlan::BruteForce, QueryPlan::DirectAddress,
+                           QueryPlan::Hashing, QueryPlan::ParallelHashing}) {
+        XCTAssertTrue(dense.FindDuplicates(plan) == expected);
+    }
+    auto gaps = sorted.FindMultipleMissingElementsSorted();
+    XCTAssertTrue(dense.FindMissing(QueryPlan::DirectAddress) == gaps);
+    XCTAssertTrue(dense.FindMissing(QueryPlan::SortedCopy) == gaps);
+    XCTAssertTrue(dense.PairWithSum(5, QueryPlan::DirectAddress) == dense.PairWithSum_Hashing(5));
+    XCTAssertTrue(dense.PairWithSum(5, QueryPlan::BruteForce) == dense.PairWithSum_Hashing(5));
+    XCTAssertFalse(dense.PairWithSum(-1).has_value());
+
+    // Narrow types: 100 + 100 wraps to -56 in int8_t, but is not a pair for -56.
+    Array<int8_t> narrow;
+    for (int i = 0; i < 38; ++i) narrow.Append(static_cast<int8_t>(60 + (i * 7) % 38));
+    narrow.Append(100);
+    narrow.Append(100);
+    Array<int8_t> narrow_sorted = narrow;
+    narrow_sorted.Sort();
+    XCTAssertTrue(narrow.PlanPairWithSum() == QueryPlan::DirectAddress);
+    for (QueryPlan plan : {QueryPlan::Auto, QueryPlan::BruteForce, QueryPlan::DirectAddress,
+                           QueryPlan::Hashing}) {
+        XCTAssertFalse(narrow.PairWithSum(-56, plan).has_value());
+        XCTAssertTrue(narrow.PairWithSum(127, plan).has_value());
+    }
+    XCTAssertFalse(narrow_sorted.PairWithSum(-56, QueryPlan::SortedScan).has_value());
+    XCTAssertTrue(narrow_sorted.PairWithSum(127, QueryPlan::SortedScan).has_value());
+    Array<uint8_t> bytes;
+    for (int v : {200, 100, 7}) bytes.Append(static_cast<uint8_t>(v));
+    XCTAssertFalse(bytes.PairWithSum(44, QueryPlan::DirectAddress).has_value());
+    auto byte_pair = std::make_pair(uint8_t(200), uint8_t(7));
+    XCTAssertTrue(bytes.PairWithSum(207, QueryPlan::DirectAddress) == byte_pair);
+
+    XCTAssertThrowsSpecific(dense.FindMissing(QueryPlan::Hashing), std::invalid_argument);
+    XCTAssertThrowsSpecific(dense.FindDuplicates(QueryPlan::SortedScan), std::invalid_argument);
+    XCTAssertThrowsSpecific(dense.FindMissing(QueryPlan::SortedScan), std::invalid_argument);
+    XCTAssertThrowsSpecific(dense.PairWithSum(5, QueryPlan::SortedScan), std::invalid_argument);
+    XCTAssertTrue(sorted.FindDuplicates(QueryPlan::SortedScan) == expected);
+    XCTAssertTrue(sorted.FindMissing(QueryPlan::SortedScan) == gaps);
+    XCTAssertThrowsSpecific(sparse.FindDuplicates(QueryPlan::DirectAddress), std::invalid_argument);
+    Array<int64_t> extremes; // 2^64 values: far too many bitmap windows
+    for (int64_t v : {INT64_MAX, int64_t(0), INT64_MIN}) extremes.Append(v);
+    XCTAssertThrowsSpecific(extremes.FindMissing(QueryPlan::DirectAddress), std::invalid_argument);
+    XCTAssertTrue(extremes.PlanFindMissing() == QueryPlan::SortedCopy);
+    Array<std::string> words;
+    words.Append("b");
+    words.Append("a");
+    words.Append("b");
+    XCTAssertThrowsSpecific(words.FindDuplicates(QueryPlan::DirectAddress), std::invalid_argument);
+    XCTAssertEqual(words.FindDuplicates(QueryPlan::Hashing).size(), 1u);
+}
+
+- (void)testSumIndexCountsAndEnumeratesTuples {
+    Array<int> arr;
+    for (int v : {1, 2, 2, 3, 4, 5, 5, 5}) arr.Append(v);
+    SumIndex<int> index(arr);
+    XCTAssertEqual(index.Size(), 8u);
+    XCTAssertEqual(index.DistinctCount(), 5u);
+    XCTAssertEqual(index.Count(5), 3u);
+
+    // 7 = 2+5 (2 * 3 ways) + 3+4 (1 way); 10 = 5+5 (3 ways).
+    XCTAssertEqual(index.CountPairs(7), 7u);
+    XCTAssertEqual(index.CountPairs(10), 3u);
+    auto pairs = index.AllPairs(7);
+    XCTAssertEqual(pairs.size(), 2u);
+    XCTAssertTrue(pairs[0] == std::make_pair(2, 5));
+    XCTAssertTrue(pairs[1] == std::make_pair(3, 4));
+    XCTAssertTrue(index.FindPair(10) == std::make_pair(5, 5));
+    XCTAssertFalse(index.FindPair(2).has_value()); // 1 occurs only once
+    XCTAssertFalse(index.FindPair(11).has_value());
+
+    // 15 = 5+5+5 (1 way); 14 = 4+5+5 (3 ways).
+    XCTAssertEqual(index.CountTriples(15), 1u);
+    XCTAssertEqual(index.CountTriples(14), 3u);
+    auto triples = index.AllTriples(9);
+    XCTAssertEqual(triples.size(), 3u); // 1+3+5, 2+2+5, 2+3+4; 1+4+4 needs two 4s
+    XCTAssertEqual(index.CountQuads(20), 0u);
+    XCTAssertEqual(index.CountQuads(17), 5u); // 2+5+5+5 (2 ways), 3+4+5+5 (3 ways)
+    size_t seen = 0;
+    index.ForEachQuad(12, [&](const SumIndex<int>::Quad &) { return ++seen < 2; });
+    XCTAssertEqual(seen, 2u); // stopped early
+}
+
+- (void)testSumIndexBatchesMatchSingleQueries {
+    Array<int> arr;
+    for (int i = 0; i < 3000; ++i) arr.Append((i * 7919) % 5003 - 2500);
+    SumIndex<int> index(arr);
+    std::vector<int> targets;
+    for (int k = -6000; k <= 6000; k += 37) targets.push_back(k);
+
+    auto found = index.FindPairs(targets, 4);
+    auto counted = index.CountPairs(targets, 0);
+    auto tripled = index.CountTriples(std::span<const int>(targets).first(20), 2);
+    for (size_t i = 0; i < targets.size(); ++i) {
+        XCTAssertTrue(found[i] == index.FindPair(targets[i]));
+        XCTAssertEqual(counted[i], index.CountPairs(targets[i]));
+        XCTAssertEqual(found[i].has_value(), counted[i] > 0);
+        XCTAssertEqual(found[i].has_value(), arr.PairWithSum_Hashing(targets[i]).has_value());
+    }
+    for (size_t i = 0; i < tripled.size(); ++i) XCTAssertEqual(tripled[i], index.CountTriples(targets[i]));
+}
+
+- (void)testSingleMissingUnsortedUsesClosedFormRange {
+    Array<int> arr;
+    for (int v : {-3, 1, -1, 0, 2, -2}) arr.Append(v); // 3 missing past -3..2
+    XCTAssertEqual(arr.FindSingleMissingElementUnsortedOptimal(), std::optional<int>(3));
+    Array<int> gap;
+    for (int v : {14, 10, 13, 11}) gap.Append(v);
+    XCTAssertEqual(gap.FindSingleMissingElementUnsortedOptimal(), std::optional<int>(12));
+}
+
+- (void)testSequenceDigestSolvesMissingAndDuplicated {
+    auto diagnose = [](std::vector<long long> values, long long first, uint64_t count) {
+        SequenceDigest<long long> digest(first, count);
+        for (size_t i = 0; i < values.size(); i += 3)
+            digest.Append(std::span<const long long>(values).subspan(i, std::min<size_t>(3, values.size() - i)));
+        return digest.Diagnose();
+    };
+    // 1 and 2 missing leave the same sum and XOR as 0 and 3 missing.
+    auto two = diagnose({-5, -2, -1, 0, -6}, -6, 7);
+    XCTAssertTrue(two.has_value());
+    XCTAssertTrue(two->missing == std::vector<long long>({-4, -3}));
+    auto one = diagnose({10, 12, 11, 14}, 10, 5);
+    XCTAssertTrue(one->missing == std::vector<long long>({13}));
+    auto swapped = diagnose({0, 1, 1, 3}, 0, 4);
+    XCTAssertTrue(swapped->missing == std::vector<long long>({2}));
+    XCTAssertTrue(swapped->duplicated == std::vector<long long>({1}));
+    auto clean = diagnose({3, 0, 2, 1, 99}, 0, 4);
+    XCTAssertTrue(clean->missing.empty() && clean->duplicated.empty());
+    XCTAssertFalse(diagnose({0, 1}, 0, 5).has_value()); // three missing: detected only
+
+    // Two short of the count, but all one value: the sums are far from any
+    // two missing values, and are rejected before they are squared.
+    SequenceDigest<uint64_t> repeated(0, uint64_t(1) << 20);
+    std::vector<uint64_t> last((uint64_t(1) << 20) - 2, (uint64_t(1) << 20) - 1);
+    repeated.Append(std::span<const uint64_t>(last));
+    XCTAssertFalse(repeated.Diagnose().has_value());
+
+    SequenceDigest<int> digest(0, 4);
+    for (int v : {3, 0, 2, 1}) digest.Append(v);
+    XCTAssertTrue(digest.Complete());
+    digest.Append(-1);
+    XCTAssertEqual(digest.OutOfRange(), 1u);
+    XCTAssertThrowsSpecific(SequenceDigest<uint64_t>(0, kMaxSequenceDigestRange + 1), std::length_error);
+}
+
+- (void)testSequenceTrackerFlagsAsChunksArrive {
+    SequenceTracker<int> tracker(100, 200);
+    std::vector<std::pair<int, SequenceFlag>> flags;
+    auto flag = [&](const int &v, SequenceFlag why) { flags.emplace_back(v, why); };
+    std::vector<int> first_chunk, second_chunk = {100, 400, 170};
+    for (int v = 100; v < 180; ++v) if (v != 150) first_chunk.push_back(v);
+    tracker.Append(std::span<const int>(first_chunk), flag);
+    XCTAssertTrue(flags.empty());
+    XCTAssertEqual(tracker.ContiguousPrefix(), 50u);
+    tracker.Append(std::span<const int>(second_chunk), flag);
+    XCTAssertEqual(flags.size(), 3u);
+    XCTAssertTrue(flags[1] == std::make_pair(400, SequenceFlag::OutOfRange));
+    XCTAssertEqual(tracker.Duplicates(), 2u);
+    auto gaps = tracker.Missing();
+    XCTAssertEqual(gaps.size(), 2u);
+    XCTAssertTrue(gaps[0] == (MissingRange<int>{150, 151}));
+    XCTAssertTrue(gaps[1] == (MissingRange<int>{180, 300}));
+    XCTAssertTrue(tracker.Append(150));
+    XCTAssertEqual(tracker.ContiguousPrefix(), 80u);
+    XCTAssertFalse(tracker.Complete());
+}
+
+- (void)testReadChunksFeedsStreamingChecks {
+    std::istringstream in("5 3 0 1 7 4 6");
+    SequenceDigest<int> digest(0, 8);
+    SequenceTracker<int> tracker(0, 8);
+    size_t chunks = 0;
+    uint64_t read = ReadChunks<int>(in, 3, [&](std::span<const int> chunk) {
+        ++chunks;
+        digest.Append(chunk);
+        tracker.Append(chunk);
+    });
+    XCTAssertEqual(read, 7u);
+    XCTAssertEqual(chunks, 3u);
+    XCTAssertTrue(digest.Diagnose()->missing == std::vector<int>({2}));
+    XCTAssertTrue(tracker.Missing() == std::vector<MissingRange<int>>({{2, 3}}));
+}
+
 @end
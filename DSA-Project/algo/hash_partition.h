@@ -0,0 +1,84 @@
+//
+//  hash_partition.h
+//  DSA-Project
+//
+//  Created by richie on 10/19/26.
+//
+
+#ifndef HASH_PARTITION_H
+#define HASH_PARTITION_H
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "parallel.h"
+
+// Radix partitioning by hash: scatters values into 2^bits partitions keyed by
+// the top bits of a 64-bit hash, so that equal values always land in the
+// same partition and each partition can be processed on its own, by its own
+// thread, with a table small enough to stay in cache.
+//
+// The scatter is stable: each partition holds its values in input order,
+// whatever the thread count.
+
+// Most partitions written in one pass. Each one is a separate output stream,
+// and past a few thousand the scatter thrashes the TLB.
+inline constexpr unsigned kMaxHashPartitionBits = 12;
+
+// Number of partition bits that gives about `per_partition` values each,
+// capped at kMaxHashPartitionBits.
+inline unsigned hash_partition_bits(size_t n, size_t per_partition) {
+  unsigned bits = 0;
+  while (bits < kMaxHashPartitionBits && (n >> bits) > per_partition)
+    ++bits;
+  return bits;
+}
+
+// Copies values[0..n) into `out`, grouped by partition hash(v) >> (64 - bits),
+// using up to `threads` threads (0 = one per hardware thread). Returns the
+// 2^bits + 1 partition boundaries: partition p is out[bounds[p], bounds[p+1]).
+//
+// Each thread counts its own slice of the input, a prefix sum turns the
+// counts into private write offsets, and each thread then scatters its slice
+// with no synchronization.
+template <typename T, typename HashFn>
+std::vector<size_t> hash_partition(const T *values, size_t n, unsigned bits,
+                                   HashFn hash, T *out, size_t threads) {
+  const size_t parts = size_t(1) << bits;
+  auto partition_of = [&](const T &v) -> size_t {
+    return bits == 0 ? 0 : static_cast<size_t>(hash(v) >> (64 - bits));
+  };
+  size_t workers = std::max<size_t>(
+      1, std::min(resolve_thread_count(threads), n / parts));
+  auto slice = [&](size_t w) { return n * w / workers; };
+
+  // counts[w][p]: values of partition p in worker w's slice; after the
+  // prefix sum, where worker w writes its next value of partition p.
+  std::vector<std::vector<size_t>> counts(workers,
+                                          std::vector<size_t>(parts, 0));
+  parallel_for(workers, [&](size_t w) {
+    for (size_t i = slice(w); i < slice(w + 1); ++i)
+      ++counts[w][partition_of(values[i])];
+  });
+  std::vector<size_t> bounds(parts + 1, 0);
+  size_t offset = 0;
+  for (size_t p = 0; p < parts; ++p) {
+    bounds[p] = offset;
+    for (size_t w = 0; w < workers; ++w) {
+      size_t count = counts[w][p];
+      counts[w][p] = offset;
+      offset += count;
+    }
+  }
+  bounds[parts] = offset;
+  parallel_for(workers, [&](size_t w) {
+    std::vector<size_t> &next = counts[w];
+    for (size_t i = slice(w); i < slice(w + 1); ++i)
+      out[next[partition_of(values[i])]++] = values[i];
+  });
+  return bounds;
+}
+
+#endif // HASH_PARTITION_H
@@ -0,0 +1,116 @@
+//
+//  loser_tree.h
+//  DSA-Project
+//
+//  Created by richie on 10/19/26.
+//
+
+#ifndef LOSER_TREE_H
+#define LOSER_TREE_H
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Tournament tree for merging k sorted ranges. Each internal node remembers
+// the loser of the match played there, so after the winner advances only the
+// matches on its leaf-to-root path are replayed: one comparison per level,
+// log2(k) per element, against k - 1 for a linear scan of the heads.
+//
+// Ties go to the lower source index, so equal elements come out in source
+// order and the merge is stable.
+template <typename T> class LoserTree {
+public:
+  struct Range {
+    const T *first;
+    const T *last;
+  };
+
+  explicit LoserTree(const std::vector<Range> &sources)
+      : leaves(std::bit_ceil(std::max<size_t>(sources.size(), 1))),
+        end(leaves, nullptr), nodes(leaves) {
+    std::vector<Node> heads(leaves);
+    for (size_t s = 0; s < leaves; ++s) {
+      // Padding leaves stay empty and lose every match.
+      heads[s].source = s;
+      if (s < sources.size() && sources[s].first != sources[s].last) {
+        heads[s].head = sources[s].first;
+        end[s] = sources[s].last;
+      }
+    }
+    nodes[0] = Build(1, heads);
+  }
+
+  bool Empty() const { return nodes[0].head == nullptr; }
+
+  // The smallest remaining element and the source it came from.
+  const T &Top() const { return *nodes[0].head; }
+  const T *TopPointer() const { return nodes[0].head; }
+  size_t TopSource() const { return nodes[0].source; }
+
+  // Advances the winning source by one and replays its path to the root.
+  void Pop() {
+    Node winner = nodes[0];
+    if (++winner.head == end[winner.source])
+      winner.head = nullptr;
+    for (size_t node = (winner.source + leaves) / 2; node >= 1; node /= 2) {
+      Node &slot = nodes[node];
+      SwapIf(Beats(slot, winner), slot, winner);
+    }
+    nodes[0] = winner;
+  }
+
+private:
+  // A source's current head, or nullptr once it is exhausted. Keeping the
+  // head pointer in the node saves a dependent load per level.
+  struct Node {
+    const T *head = nullptr;
+    size_t source = 0;
+  };
+
+  size_t leaves; // number of sources rounded up to a power of two
+  std::vector<const T *> end;
+  std::vector<Node> nodes; // nodes[0] holds the overall winner
+
+  static bool Beats(const Node &a, const Node &b) {
+    if (a.head == nullptr || b.head == nullptr)
+      return b.head == nullptr && a.head != nullptr;
+    const T &x = *a.head, &y = *b.head;
+    // Non-short-circuit operators keep this free of branches.
+    return (x < y) | (!(y < x) & (a.source < b.source));
+  }
+
+  // Swaps a and b when `cond` holds, using masks rather than a branch: the
+  // outcome of each match is as good as random on interleaved inputs, so a
+  // branch would mispredict about half the time, and compilers turn a
+  // ternary on a two-word struct back into one.
+  static void SwapIf(bool cond, Node &a, Node &b) {
+    uintptr_t mask = 0 - static_cast<uintptr_t>(cond);
+    uintptr_t ah = reinterpret_cast<uintptr_t>(a.head);
+    uintptr_t bh = reinterpret_cast<uintptr_t>(b.head);
+    uintptr_t dh = (ah ^ bh) & mask;
+    size_t ds = (a.source ^ b.source) & mask;
+    a.head = reinterpret_cast<const T *>(ah ^ dh);
+    b.head = reinterpret_cast<const T *>(bh ^ dh);
+    a.source ^= ds;
+    b.source ^= ds;
+  }
+
+  // Plays the matches below `node`, stores each loser and returns the winner.
+  Node Build(size_t node, const std::vector<Node> &heads) {
+    if (node >= leaves)
+      return heads[node - leaves];
+    Node left = Build(2 * node, heads), right = Build(2 * node + 1, heads);
+    if (Beats(left, right)) {
+      nodes[node] = right;
+      return left;
+    }
+    nodes[node] = left;
+    return right;
+  }
+};
+
+#endif // LOSER_TREE_H
@@ -0,0 +1,58 @@
+//
+//  merge_path.h
+//  DSA-Project
+//
+//  Created by richie on 10/19/26.
+//
+
+#ifndef MERGE_PATH_H
+#define MERGE_PATH_H
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+
+// Merge-path partitioning (Odeh et al.; Green et al.). Merging a[0, na) and
+// b[0, nb) walks a path through the na x nb grid; the point where it crosses
+// diagonal d says how many of the first d merged elements come from each
+// input. Cutting at evenly spaced diagonals splits the merge into slices of
+// equal output size that can be merged independently.
+
+// Returns (i, j) with i + j == diag such that a[0, i) and b[0, j) are exactly
+// the first `diag` elements of the stable merge, where ties take a first.
+// O(log min(na, nb)).
+template <typename T>
+std::pair<size_t, size_t> merge_path_split(const T *a, size_t na, const T *b,
+                                           size_t nb, size_t diag) {
+  size_t lo = diag > nb ? diag - nb : 0;
+  size_t hi = std::min(diag, na);
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    // a[mid] precedes b[diag - mid - 1] in the merge: take more from a.
+    if (!(b[diag - mid - 1] < a[mid]))
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return {lo, diag - lo};
+}
+
+// Like merge_path_split, but moves the cut back to the start of the run of
+// equal values it falls in, so every value lies wholly on one side. Set
+// operations pair equal elements across the inputs and need that; the slices
+// then produce exactly what one pass over the whole input would. Slices can
+// come out uneven when a single value repeats many times.
+template <typename T>
+std::pair<size_t, size_t> merge_path_value_split(const T *a, size_t na,
+                                                 const T *b, size_t nb,
+                                                 size_t diag) {
+  auto [i, j] = merge_path_split(a, na, b, nb, diag);
+  if (i == na && j == nb)
+    return {i, j};
+  // The next element of the merge; everything before the cut is <= it.
+  const T &next = (j == nb || (i < na && !(b[j] < a[i]))) ? a[i] : b[j];
+  return {static_cast<size_t>(std::lower_bound(a, a + i, next) - a),
+          static_cast<size_t>(std::lower_bound(b, b + j, next) - b)};
+}
+
+#endif // MERGE_PATH_H
@@ -0,0 +1,54 @@
+//
+//  parallel.h
+//  DSA-Project
+//
+//  Created by richie on 10/19/26.
+//
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+// Minimal fork-join helpers shared by the parallel algorithms. Work is split
+// into a fixed number of parts up front; there is no pool or work stealing,
+// so callers should make parts large enough to amortize a thread start.
+
+// `requested` threads, or one per hardware thread when it is 0.
+inline size_t resolve_thread_count(size_t requested) {
+  if (requested > 0)
+    return requested;
+  return std::max<size_t>(1, std::thread::hardware_concurrency());
+}
+
+// Calls fn(p) for every p in [0, parts), part 0 on the calling thread and the
+// rest on their own threads, and waits for all of them. If any part throws,
+// the exception from the lowest-numbered failing part is rethrown.
+template <typename Fn> void parallel_for(size_t parts, Fn &&fn) {
+  if (parts == 0)
+    return;
+  std::vector<std::exception_ptr> errors(parts);
+  auto run = [&](size_t p) {
+    try {
+      fn(p);
+    } catch (...) {
+      errors[p] = std::current_exception();
+    }
+  };
+  std::vector<std::thread> workers;
+  workers.reserve(parts - 1);
+  for (size_t p = 1; p < parts; ++p)
+    workers.emplace_back(run, p);
+  run(0);
+  for (std::thread &worker : workers)
+    worker.join();
+  for (const std::exception_ptr &error : errors)
+    if (error)
+      std::rethrow_exception(error);
+}
+
+#endif // PARALLEL_H
@@ -0,0 +1,368 @@
+//
+//  permutations.h
+//  DSA-Project
+//
+//  Created by richie on 10/19/26.
+//
+
+#ifndef PERMUTATIONS_H
+#define PERMUTATIONS_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "parallel.h"
+#include "result_sink.h"
+
+// Lazy permutation enumeration. generate_permutations in strings.h returns
+// every permutation as its own std::string, which for 11 characters is 40M
+// allocations and gigabytes of memory; the generators here rearrange a
+// single buffer in place and hand out views of it, so memory stays O(n) no
+// matter how many permutations are visited.
+//
+// A view is valid until the generator advances. Copy it into a std::string
+// to keep it.
+//
+// Permutations can also be addressed by rank, their position in the
+// lexicographic order of index arrangements (permutation r of s is
+// s[order[0]] s[order[1]] ... for order = unrank_permutation(n, r)). Ranks
+// let an enumeration be split into ranges, across threads with
+// for_each_permutation_parallel or across processes by handing each one a
+// range, and resumed from where it stopped.
+
+// Every arrangement of a string's characters, by Heap's algorithm: each
+// permutation differs from the previous one by a single swap, so advancing
+// is O(1) amortized. Characters are treated as distinct by position, so a
+// string with repeated characters yields repeated permutations, n! in all.
+//
+// Usable directly (Current / Next) or as a single-pass range:
+//
+//   for (std::string_view p : PermutationGenerator("abc")) ...
+class PermutationGenerator {
+public:
+  explicit PermutationGenerator(std::string_view s)
+      : buffer(s), counters(s.size(), 0) {}
+
+  // The current permutation; the input itself before the first Next.
+  std::string_view Current() const { return buffer; }
+
+  // Moves to the next permutation. Returns false, leaving the buffer in an
+  // unspecified arrangement, once all n! have been produced.
+  bool Next() {
+    // Iterative Heap's algorithm: counters[level] counts the swaps made at
+    // that level since the levels above it last moved.
+    const size_t n = buffer.size();
+    while (level < n) {
+      if (counters[level] < level) {
+        std::swap(buffer[level % 2 == 0 ? 0 : counters[level]], buffer[level]);
+        ++counters[level];
+        level = 1;
+        return true;
+      }
+      counters[level] = 0;
+      ++level;
+    }
+    return false;
+  }
+
+  class Iterator {
+  public:
+    using value_type = std::string_view;
+    using difference_type = std::ptrdiff_t;
+
+    Iterator() = default;
+    explicit Iterator(PermutationGenerator *generator) : generator(generator) {}
+
+    std::string_view operator*() const { return generator->Current(); }
+    Iterator &operator++() {
+      if (!generator->Next())
+        generator = nullptr;
+      return *this;
+    }
+    void operator++(int) { ++*this; }
+    bool operator==(std::default_sentinel_t) const {
+      return generator == nullptr;
+    }
+
+  private:
+    PermutationGenerator *generator = nullptr;
+  };
+
+  // The range starts from the current permutation, so it is meant to be
+  // iterated once, from a fresh generator.
+  Iterator begin() { return Iterator(this); }
+  std::default_sentinel_t end() const { return std::default_sentinel; }
+
+private:
+  std::string buffer;
+  std::vector<size_t> counters;
+  size_t level = 1;
+};
+
+// Calls fn(std::string_view) for each of the n! permutations of s, in the
+// generator's order. fn may return bool; returning false stops the
+// enumeration, and then this returns false.
+template <typename Fn> bool for_each_permutation(std::string_view s, Fn &&fn) {
+  PermutationGenerator generator(s);
+  do {
+    if (!invoke_sink(fn, generator.Current()))
+      return false;
+  } while (generator.Next());
+  return true;
+}
+
+// --- Ranks ---
+
+// Longest string whose n! permutations can be ranked in 64 bits.
+inline constexpr size_t kMaxRankedPermutationLength = 20;
+
+// Ranks handed to a parallel worker at a time. Each block starts with an
+// O(n^2) unrank, which is noise next to this many steps.
+inline constexpr uint64_t kPermutationRankBlock = uint64_t(1) << 14;
+
+// n!. Throws std::length_error past kMaxRankedPermutationLength.
+inline uint64_t permutation_count(size_t n) {
+  if (n > kMaxRankedPermutationLength)
+    throw std::length_error("permutation ranks need n <= 20");
+  uint64_t count = 1;
+  for (size_t i = 2; i <= n; ++i)
+    count *= i;
+  return count;
+}
+
+// The permutation of 0..n-1 at `rank` in lexicographic order. The digits of
+// the rank in the factorial number system pick, one position at a time,
+// which of the remaining indices comes next. Throws std::out_of_range if
+// rank >= n!.
+inline std::vector<size_t> unrank_permutation(size_t n, uint64_t rank) {
+  uint64_t block = permutation_count(n);
+  if (rank >= block)
+    throw std::out_of_range("permutation rank out of range");
+  std::vector<size_t> remaining(n);
+  std::iota(remaining.begin(), remaining.end(), size_t(0));
+  std::vector<size_t> order;
+  order.reserve(n);
+  for (size_t left = n; left > 0; --left) {
+    block /= left; // permutations sharing each choice of this position
+    size_t digit = static_cast<size_t>(rank / block);
+    rank %= block;
+    order.push_back(remaining[digit]);
+    remaining.erase(remaining.begin() + static_cast<std::ptrdiff_t>(digit));
+  }
+  return order;
+}
+
+// Inverse of unrank_permutation. Throws std::invalid_argument if `order` is
+// not a permutation of 0..n-1.
+inline uint64_t rank_permutation(std::span<const size_t> order) {
+  const size_t n = order.size();
+  permutation_count(n); // length check
+  std::vector<bool> seen(n, false);
+  uint64_t rank = 0;
+  for (size_t i = 0; i < n; ++i) {
+    if (order[i] >= n || seen[order[i]])
+      throw std::invalid_argument("not a permutation of 0..n-1");
+    seen[order[i]] = true;
+    // Digit i: later indices smaller than this one, i.e. the choices that
+    // sort before it at this position.
+    size_t digit = 0;
+    for (size_t j = i + 1; j < n; ++j)
+      digit += order[j] < order[i];
+    rank = rank * (n - i) + digit;
+  }
+  return rank;
+}
+
+// Permutation `rank` of s. When the characters of s are distinct and in
+// increasing order, ranks follow the lexicographic order of the strings.
+inline std::string permutation_at(std::string_view s, uint64_t rank) {
+  std::string out;
+  out.reserve(s.size());
+  for (size_t index : unrank_permutation(s.size(), rank))
+    out.push_back(s[index]);
+  return out;
+}
+
+// Permutations of a string in rank order, from a given rank. Each step is
+// next_permutation on the index arrangement, mirrored on the characters:
+// one swap and one suffix reversal, O(1) amortized.
+class RankedPermutationGenerator {
+public:
+  explicit RankedPermutationGenerator(std::string_view s, uint64_t rank = 0)
+      : order(unrank_permutation(s.size(), rank)), current_rank(rank) {
+    buffer.reserve(s.size());
+    for (size_t index : order)
+      buffer.push_back(s[index]);
+  }
+
+  std::string_view Current() const { return buffer; }
+  uint64_t Rank() const { return current_rank; }
+
+  // Moves to the next rank. Returns false after the last permutation.
+  bool Next() {
+    const size_t n = order.size();
+    size_t i = n;
+    while (i > 1 && order[i - 2] > order[i - 1])
+      --i;
+    if (i <= 1)
+      return false;
+    size_t j = n - 1;
+    while (order[j] < order[i - 2])
+      --j;
+    std::swap(order[i - 2], order[j]);
+    std::swap(buffer[i - 2], buffer[j]);
+    std::reverse(order.begin() + static_cast<std::ptrdiff_t>(i - 1),
+                 order.end());
+    std::reverse(buffer.begin() + static_cast<std::ptrdiff_t>(i - 1),
+                 buffer.end());
+    ++current_rank;
+    return true;
+  }
+
+private:
+  std::vector<size_t> order;
+  std::string buffer;
+  uint64_t current_rank;
+};
+
+// Calls fn(std::string_view) for the permutations of s with ranks in
+// [first, last), in rank order; last is clamped to n!. fn may return bool;
+// returning false stops, and then this returns false.
+template <typename Fn>
+bool for_each_permutation_in_range(std::string_view s, uint64_t first,
+                                   uint64_t last, Fn &&fn) {
+  last = std::min(last, permutation_count(s.size()));
+  if (first >= last)
+    return true;
+  RankedPermutationGenerator generator(s, first);
+  for (uint64_t rank = first;; ++rank) {
+    if (!invoke_sink(fn, generator.Current()))
+      return false;
+    if (rank + 1 == last)
+      return true;
+    generator.Next();
+  }
+}
+
+// for_each_permutation_in_range split across up to `threads` threads (0 =
+// one per hardware thread). Workers claim blocks of kPermutationRankBlock
+// ranks from a shared counter, unrank the block's first permutation and
+// step through the rest, calling fn(worker, std::string_view) with their
+// own worker index in [0, threads), so per-thread results can be kept in a
+// slot per worker without locking. Ranks ascend within a block; blocks are
+// visited in no particular order. Returning false from fn stops that worker
+// at once and the others at the end of their current block, and then this
+// returns false.
+template <typename Fn>
+bool for_each_permutation_parallel(std::string_view s, uint64_t first,
+                                   uint64_t last, size_t threads, Fn &&fn) {
+  last = std::min(last, permutation_count(s.size()));
+  if (first >= last)
+    return true;
+  const uint64_t blocks =
+      (last - first + kPermutationRankBlock - 1) / kPermutationRankBlock;
+  const size_t workers = static_cast<size_t>(
+      std::min<uint64_t>(resolve_thread_count(threads), blocks));
+  std::atomic<uint64_t> next_block{0};
+  std::atomic<bool> stopped{false};
+  parallel_for(workers, [&](size_t worker) {
+    for (uint64_t b; !stopped.load(std::memory_order_relaxed) &&
+                     (b = next_block.fetch_add(1)) < blocks;) {
+      uint64_t lo = first + b * kPermutationRankBlock;
+      uint64_t hi = std::min(last, lo + kPermutationRankBlock);
+      bool go_on = for_each_permutation_in_range(
+          s, lo, hi, [&](std::string_view p) {
+            return invoke_sink(fn, worker, p);
+          });
+      if (!go_on)
+        stopped.store(true, std::memory_order_relaxed);
+    }
+  });
+  return !stopped.load();
+}
+
+// Every permutation of s, in parallel.
+template <typename Fn>
+bool for_each_permutation_parallel(std::string_view s, size_t threads,
+                                   Fn &&fn) {
+  return for_each_permutation_parallel(s, 0, permutation_count(s.size()),
+                                       threads, std::forward<Fn>(fn));
+}
+
+// --- Multiset permutations ---
+
+// Each distinct arrangement of a string's characters exactly once, in
+// lexicographic order: "aabbcc" gives its 90 arrangements instead of 720.
+// The buffer starts sorted and each step is the classic next-permutation
+// (find the rightmost ascent, swap in the next larger character, reverse
+// the suffix), which skips equal characters by itself and is O(1)
+// amortized.
+class DistinctPermutationGenerator {
+public:
+  explicit DistinctPermutationGenerator(std::string_view s) : buffer(s) {
+    std::sort(buffer.begin(), buffer.end());
+  }
+
+  // The current permutation; the sorted characters before the first Next.
+  std::string_view Current() const { return buffer; }
+
+  // Moves to the next distinct permutation. Returns false after the last
+  // one, leaving the buffer sorted again.
+  bool Next() { return std::next_permutation(buffer.begin(), buffer.end()); }
+
+private:
+  std::string buffer;
+};
+
+// Calls fn(std::string_view) for each distinct permutation of s in
+// lexicographic order. fn may return bool; returning false stops, and then
+// this returns false.
+template <typename Fn>
+bool for_each_distinct_permutation(std::string_view s, Fn &&fn) {
+  DistinctPermutationGenerator generator(s);
+  do {
+    if (!invoke_sink(fn, generator.Current()))
+      return false;
+  } while (generator.Next());
+  return true;
+}
+
+// Number of distinct permutations of s, n! / (c1! c2! ...) for the counts
+// c of each character, without enumerating them. Computed as a product of
+// binomials C(c1 + ... + ck, ck), each built up exactly one factor at a
+// time. Throws std::overflow_error if the count does not fit in 64 bits.
+inline uint64_t count_distinct_permutations(std::string_view s) {
+  size_t counts[256] = {};
+  for (char c : s)
+    ++counts[static_cast<unsigned char>(c)];
+  unsigned __int128 total = 1;
+  uint64_t placed = 0;
+  for (size_t count : counts) {
+    // C(placed + count, count), exact at each step: the running value is
+    // C(placed + i, i) after step i.
+    unsigned __int128 binomial = 1;
+    for (size_t i = 1; i <= count; ++i) {
+      binomial = binomial * (placed + i) / i;
+      if (binomial > UINT64_MAX)
+        throw std::overflow_error("distinct permutation count overflows");
+    }
+    placed += count;
+    total *= binomial;
+    if (total > UINT64_MAX)
+      throw std::overflow_error("distinct permutation count overflows");
+  }
+  return static_cast<uint64_t>(total);
+}
+
+#endif // PERMUTATIONS_H
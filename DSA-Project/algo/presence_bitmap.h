@@ -0,0 +1,134 @@
+//
+//  presence_bitmap.h
+//  DSA-Project
+//
+//  Created by richie on 10/19/26.
+//
+
+#ifndef PRESENCE_BITMAP_H
+#define PRESENCE_BITMAP_H
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "parallel.h"
+#include "result_sink.h"
+
+// Presence bitmaps over 64-bit words, for finding which values of a range do
+// not occur in an unsorted input. Bit i of a window stands for the value
+// base + i. Marking is branch-free, and the gap scan skips whole words, so
+// cost depends on the number of gaps rather than on testing every bit.
+//
+// A range wider than kPresenceChunkBits is covered one window at a time:
+// each window re-reads the input and marks only the values that fall in it.
+
+// Largest window marked at once: 2^30 bits, a 128 MiB bitmap.
+inline constexpr uint64_t kPresenceChunkBits = uint64_t(1) << 30;
+
+// Below this many bits per thread, splitting the marking is not worth a
+// thread start.
+inline constexpr uint64_t kPresenceMinBitsPerThread = uint64_t(1) << 22;
+
+// Words needed for a window of `bits` bits.
+inline size_t presence_words(uint64_t bits) {
+  return static_cast<size_t>((bits + 63) / 64);
+}
+
+// How many values ahead mark_present prefetches the word it will update.
+inline constexpr size_t kPresencePrefetchDistance = 32;
+
+// Sets bit (v - base) in `words` for each of the n values v that falls in
+// [base, base + bits). Values outside the window OR a zero into word 0
+// instead of taking a branch, so the loop cost does not depend on the data.
+// The updates land on random words of a large bitmap, so each word is
+// prefetched a few dozen values early to keep several misses in flight.
+template <typename T>
+void mark_present(const T *values, size_t n, std::make_unsigned_t<T> base,
+                  uint64_t bits, uint64_t *words) {
+  static_assert(std::is_integral_v<T>, "presence bitmaps need integers");
+  using U = std::make_unsigned_t<T>;
+  auto offset_of = [&](size_t i) -> uint64_t {
+    return static_cast<U>(static_cast<U>(values[i]) - base);
+  };
+  // Word holding `offset`, or 0 when it falls outside the window.
+  auto word_of = [bits](uint64_t offset) -> size_t {
+    return (offset >> 6) & (0 - uint64_t(offset < bits));
+  };
+  auto mark = [&](uint64_t offset) {
+    words[word_of(offset)] |= uint64_t(offset < bits) << (offset & 63);
+  };
+  size_t i = 0;
+  for (; i + kPresencePrefetchDistance < n; ++i) {
+    size_t ahead = word_of(offset_of(i + kPresencePrefetchDistance));
+    __builtin_prefetch(words + ahead, 1);
+    mark(offset_of(i));
+  }
+  for (; i < n; ++i)
+    mark(offset_of(i));
+}
+
+// mark_present split across up to `threads` threads (0 = one per hardware
+// thread). Each thread owns a contiguous slice of whole words and scans all
+// of the values, so no two threads write the same word and no atomics are
+// needed. Small windows are marked on the calling thread.
+template <typename T>
+void mark_present_parallel(const T *values, size_t n,
+                           std::make_unsigned_t<T> base, uint64_t bits,
+                           uint64_t *words, size_t threads) {
+  using U = std::make_unsigned_t<T>;
+  size_t parts = std::min<uint64_t>(resolve_thread_count(threads),
+                                    bits / kPresenceMinBitsPerThread);
+  if (parts <= 1) {
+    mark_present(values, n, base, bits, words);
+    return;
+  }
+  size_t total_words = presence_words(bits);
+  parallel_for(parts, [&](size_t p) {
+    size_t first = total_words * p / parts;
+    size_t last = total_words * (p + 1) / parts;
+    uint64_t slice_bits = std::min<uint64_t>(bits, uint64_t(last) * 64) -
+                          uint64_t(first) * 64;
+    mark_present(values, n, static_cast<U>(base + uint64_t(first) * 64),
+                 slice_bits, words + first);
+  });
+}
+
+// Calls fn(lo, hi) for each maximal run of clear bits [lo, hi) within
+// [0, bits), in increasing order. Words with every bit set are skipped whole,
+// and count-trailing-zeros finds the ends of each run without testing bits
+// one at a time. fn may return bool; returning false stops the scan, and
+// then this returns false.
+template <typename Fn>
+bool for_each_clear_run(const uint64_t *words, uint64_t bits, Fn &&fn) {
+  const size_t nwords = presence_words(bits);
+  uint64_t pos = 0;
+  while (pos < bits) {
+    // Next clear bit at or after pos.
+    size_t w = static_cast<size_t>(pos >> 6);
+    uint64_t clear = ~words[w] & (~uint64_t(0) << (pos & 63));
+    while (clear == 0) {
+      if (++w == nwords)
+        return true;
+      clear = ~words[w];
+    }
+    uint64_t lo = uint64_t(w) * 64 + std::countr_zero(clear);
+    if (lo >= bits)
+      return true; // only padding past the end of the window
+    // Next set bit after lo, or the end of the window.
+    uint64_t set = words[w] & (~uint64_t(0) << (lo & 63));
+    while (set == 0 && ++w < nwords)
+      set = words[w];
+    uint64_t hi =
+        set == 0 ? bits
+                 : std::min(bits, uint64_t(w) * 64 + std::countr_zero(set));
+    if (!invoke_sink(fn, lo, hi))
+      return false;
+    pos = hi;
+  }
+  return true;
+}
+
+#endif // PRESENCE_BITMAP_H
@@ -0,0 +1,32 @@
+//
+//  result_sink.h
+//  DSA-Project
+//
+//  Created by richie on 10/19/26.
+//
+
+#ifndef RESULT_SINK_H
+#define RESULT_SINK_H
+
+#include <concepts>
+#include <type_traits>
+#include <utility>
+
+// Callback that receives results one at a time. It may return void, or bool
+// where returning false stops the search early.
+template <typename F, typename R>
+concept ResultSink = std::invocable<F &, const R &>;
+
+// Calls sink(args...) and returns whether to go on: what the sink returned
+// if it returns bool, otherwise true.
+template <typename Sink, typename... Args>
+bool invoke_sink(Sink &sink, Args &&...args) {
+  if constexpr (std::is_same_v<std::invoke_result_t<Sink &, Args...>, bool>) {
+    return sink(std::forward<Args>(args)...);
+  } else {
+    sink(std::forward<Args>(args)...);
+    return true;
+  }
+}
+
+#endif // RESULT_SINK_H
@@ -0,0 +1,51 @@
+//
+//  sequence_math.h
+//  DSA-Project
+//
+//  Created by richie on 10/19/26.
+//
+
+#ifndef SEQUENCE_MATH_H
+#define SEQUENCE_MATH_H
+
+#include <cstdint>
+
+// Closed forms for the XOR, sum and sum of squares of the offsets 0..n-1,
+// so that checking a stream against an expected range never has to walk the
+// range itself. Values are compared as offsets from the start of the range,
+// which keeps the arithmetic unsigned and independent of the element type.
+
+// 0 ^ 1 ^ ... ^ n. The XOR of a run of four starting at a multiple of four
+// is zero, so only n's position within its group of four matters.
+inline uint64_t xor_upto(uint64_t n) {
+  switch (n & 3) {
+  case 0:
+    return n;
+  case 1:
+    return 1;
+  case 2:
+    return n + 1;
+  default:
+    return 0;
+  }
+}
+
+// XOR of the offsets 0..n-1; 0 for an empty range.
+inline uint64_t xor_of_offsets(uint64_t n) {
+  return n == 0 ? 0 : xor_upto(n - 1);
+}
+
+// 0 + 1 + ... + (n-1), exact for any 64-bit n.
+inline unsigned __int128 sum_of_offsets(uint64_t n) {
+  unsigned __int128 m = n;
+  return n == 0 ? 0 : m * (m - 1) / 2;
+}
+
+// 0^2 + 1^2 + ... + (n-1)^2. Exact while n <= 2^42, where the sum still
+// fits in 128 bits.
+inline unsigned __int128 square_sum_of_offsets(uint64_t n) {
+  unsigned __int128 m = n;
+  return n == 0 ? 0 : (m - 1) * m * (2 * m - 1) / 6;
+}
+
+#endif // SEQUENCE_MATH_H
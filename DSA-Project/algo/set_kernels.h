@@ -0,0 +1,274 @@
+//
+//  set_kernels.h
+//  DSA-Project
+//
+//  Created by richie on 10/19/26.
+//
+
+#ifndef SET_KERNELS_H
+#define SET_KERNELS_H
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// Merge kernels for sorted arrays of arithmetic values, used by the set
+// operations in Array<T>.
+//
+// The *_branchless kernels replace the three-way `if` of a two-pointer merge
+// with conditional moves, so random inputs no longer mispredict on every
+// step. They produce exactly what the two-pointer loops produce, duplicates
+// included.
+//
+// The *_simd kernels (int32_t / uint32_t with AVX2) follow Schlegel et al. and
+// Lemire et al.: load 8 values from each side, compare every pair at once
+// with 8 rotations of one block, then compress the matching lanes with a
+// shuffle-table lookup. They require strictly increasing inputs (no
+// duplicates) and write up to kSimdSetOutputSlack elements past the result,
+// so `out` needs that much extra room.
+
+inline constexpr size_t kSimdSetOutputSlack = 8;
+
+template <typename T>
+inline constexpr bool has_simd_set_ops =
+#if defined(__AVX2__)
+    std::is_same_v<T, int32_t> || std::is_same_v<T, uint32_t>;
+#else
+    false;
+#endif
+
+template <typename T> bool is_strictly_increasing(const T *a, size_t n) {
+  // No early exit: the OR-reduction vectorizes, which matters more than
+  // stopping early on the inputs that pass.
+  bool out_of_order = false;
+  for (size_t i = 1; i < n; ++i)
+    out_of_order |= !(a[i - 1] < a[i]);
+  return !out_of_order;
+}
+
+// Smallest index p in [lo, hi) with !(arr[p] < key), or hi. Probes lo + 1,
+// lo + 2, lo + 4, ... until it overshoots, then binary searches the last
+// step, so the cost is O(log d) where d is the distance moved.
+template <typename T>
+size_t gallop_lower_bound(const T *arr, size_t lo, size_t hi, const T &key) {
+  if (lo >= hi || !(arr[lo] < key))
+    return lo;
+  size_t prev = lo, step = 1;
+  size_t probe = lo + step;
+  while (probe < hi && arr[probe] < key) {
+    prev = probe;
+    step <<= 1;
+    probe = lo + step;
+  }
+  // arr[prev] < key, and key <= arr[probe] (or probe is past the end).
+  return std::lower_bound(arr + prev + 1, arr + std::min(probe, hi), key) -
+         arr;
+}
+
+// Estimates whether a two-pointer merge of a and b would mispredict often.
+// Replays the merge's branch decisions for a short window at a few evenly
+// spaced points and counts how often the three-way outcome changes. Interleaved
+// (random) inputs flip about every other step and favor the branch-free
+// kernels; clustered inputs advance one side in long runs, which a branch
+// predictor handles better than the branch-free kernels' fixed cost.
+template <typename T>
+bool merge_favors_branchless(const T *a, size_t na, const T *b, size_t nb) {
+  const size_t kProbes = 4, kWindow = 256;
+  size_t steps = 0, flips = 0;
+  for (size_t p = 0; p < kProbes; ++p) {
+    size_t i = na * p / kProbes;
+    if (i >= na)
+      break;
+    size_t j = std::lower_bound(b, b + nb, a[i]) - b;
+    int last = 0;
+    for (size_t s = 0; s < kWindow && i < na && j < nb; ++s, ++steps) {
+      // -1: a advances, 1: b advances, 0: equal, both advance.
+      int outcome = (b[j] < a[i]) - (a[i] < b[j]);
+      flips += (s > 0 && outcome != last);
+      last = outcome;
+      i += (outcome <= 0);
+      j += (outcome >= 0);
+    }
+  }
+  // Below one flip in eight steps the branches are predictable enough.
+  return flips * 8 > steps;
+}
+
+template <typename T>
+size_t intersect_branchless(const T *a, size_t na, const T *b, size_t nb,
+                            T *out) {
+  size_t i = 0, j = 0, k = 0;
+  while (i < na && j < nb) {
+    T x = a[i], y = b[j];
+    out[k] = x;
+    k += (x == y);
+    i += !(y < x);
+    j += !(x < y);
+  }
+  return k;
+}
+
+template <typename T>
+size_t union_branchless(const T *a, size_t na, const T *b, size_t nb, T *out) {
+  size_t i = 0, j = 0, k = 0;
+  while (i < na && j < nb) {
+    T x = a[i], y = b[j];
+    out[k++] = (y < x) ? y : x;
+    i += !(y < x);
+    j += !(x < y);
+  }
+  while (i < na)
+    out[k++] = a[i++];
+  while (j < nb)
+    out[k++] = b[j++];
+  return k;
+}
+
+template <typename T>
+size_t difference_branchless(const T *a, size_t na, const T *b, size_t nb,
+                             T *out) {
+  size_t i = 0, j = 0, k = 0;
+  while (i < na && j < nb) {
+    T x = a[i], y = b[j];
+    out[k] = x;
+    k += (x < y);
+    i += !(y < x);
+    j += !(x < y);
+  }
+  while (i < na)
+    out[k++] = a[i++];
+  return k;
+}
+
+#if defined(__AVX2__)
+
+namespace set_kernels_detail {
+
+// kCompress[mask] lists the lanes whose bit is set in `mask`, in order, so
+// permutevar8x32 packs the selected values to the front of the register.
+constexpr std::array<std::array<uint32_t, 8>, 256> make_compress_table() {
+  std::array<std::array<uint32_t, 8>, 256> table{};
+  for (uint32_t mask = 0; mask < 256; ++mask) {
+    uint32_t k = 0;
+    for (uint32_t lane = 0; lane < 8; ++lane)
+      if (mask & (1u << lane))
+        table[mask][k++] = lane;
+  }
+  return table;
+}
+
+alignas(32) inline constexpr std::array<std::array<uint32_t, 8>, 256>
+    kCompress = make_compress_table();
+
+inline __m256i load8(const void *p) {
+  return _mm256_loadu_si256(static_cast<const __m256i *>(p));
+}
+
+// Bit l is set when lane l of va equals any lane of vb.
+inline uint32_t match_mask(__m256i va, __m256i vb) {
+  const __m256i rotate = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+  __m256i hits = _mm256_cmpeq_epi32(va, vb);
+  for (int r = 1; r < 8; ++r) {
+    vb = _mm256_permutevar8x32_epi32(vb, rotate);
+    hits = _mm256_or_si256(hits, _mm256_cmpeq_epi32(va, vb));
+  }
+  return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(hits)));
+}
+
+// Writes the lanes of va selected by `mask` to out; returns how many.
+template <typename T> inline size_t compress_store(__m256i va, uint32_t mask,
+                                                   T *out) {
+  __m256i idx = _mm256_load_si256(
+      reinterpret_cast<const __m256i *>(kCompress[mask].data()));
+  _mm256_storeu_si256(reinterpret_cast<__m256i *>(out),
+                      _mm256_permutevar8x32_epi32(va, idx));
+  return static_cast<size_t>(std::popcount(mask));
+}
+
+} // namespace set_kernels_detail
+
+template <typename T>
+size_t intersect_simd(const T *a, size_t na, const T *b, size_t nb, T *out) {
+  static_assert(has_simd_set_ops<T>, "no SIMD set kernel for this type");
+  using namespace set_kernels_detail;
+  size_t i = 0, j = 0, k = 0;
+  if (na >= 8 && nb >= 8) {
+    __m256i va = load8(a), vb = load8(b);
+    while (true) {
+      // Each value of a unique set matches at most one block of the other,
+      // so emitting straight away never duplicates a result.
+      k += compress_store(va, match_mask(va, vb), out + k);
+      T a_max = a[i + 7], b_max = b[j + 7];
+      if (a_max <= b_max) {
+        i += 8;
+        if (i + 8 > na)
+          break;
+        va = load8(a + i);
+      }
+      if (b_max <= a_max) {
+        j += 8;
+        if (j + 8 > nb)
+          break;
+        vb = load8(b + j);
+      }
+    }
+  }
+  // Tails are shorter than one block; values already matched in the loop all
+  // sit before b[j], so the scalar merge cannot report them twice.
+  return k + intersect_branchless(a + i, na - i, b + j, nb - j, out + k);
+}
+
+template <typename T>
+size_t difference_simd(const T *a, size_t na, const T *b, size_t nb, T *out) {
+  static_assert(has_simd_set_ops<T>, "no SIMD set kernel for this type");
+  using namespace set_kernels_detail;
+  size_t i = 0, j = 0, k = 0;
+  uint32_t matched = 0; // lanes of the current a block seen in some b block
+  bool pending = false; // current a block compared but not yet emitted
+  if (na >= 8 && nb >= 8) {
+    __m256i va = load8(a), vb = load8(b);
+    while (true) {
+      matched |= match_mask(va, vb);
+      pending = true;
+      T a_max = a[i + 7], b_max = b[j + 7];
+      if (a_max <= b_max) {
+        // No later b block can match this a block: emit its survivors.
+        k += compress_store(va, ~matched & 0xFFu, out + k);
+        matched = 0;
+        pending = false;
+        i += 8;
+      }
+      if (b_max <= a_max)
+        j += 8;
+      if (i + 8 > na || j + 8 > nb)
+        break;
+      va = load8(a + i);
+      vb = load8(b + j);
+    }
+  }
+  if (pending) {
+    // The a block still has survivors that may match the short b tail.
+    alignas(32) T survivors[8 + kSimdSetOutputSlack];
+    size_t count =
+        compress_store(load8(a + i), ~matched & 0xFFu, survivors);
+    k += difference_branchless(survivors, count, b + j, nb - j, out + k);
+    // Skip the b values consumed by the survivors; the rest of a starts
+    // above them.
+    T last = a[i + 7];
+    while (j < nb && b[j] <= last)
+      ++j;
+    i += 8;
+  }
+  return k + difference_branchless(a + i, na - i, b + j, nb - j, out + k);
+}
+
+#endif // __AVX2__
+
+#endif // SET_KERNELS_H
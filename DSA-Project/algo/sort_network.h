@@ -0,0 +1,288 @@
+//
+//  sort_network.h
+//  DSA-Project
+//
+//  Created by richie on 10/19/26.
+//
+
+#ifndef SORT_NETWORK_H
+#define SORT_NETWORK_H
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// Branch-free bitonic sorting networks for small buffers of int32_t, float
+// and int64_t. A network always performs the same compare-exchanges in the
+// same order, so there are no data-dependent branches to mispredict. With
+// AVX2 each compare-exchange works on a whole register (8 x int32/float or
+// 4 x int64); without it the same network runs on scalar min/max.
+//
+// Floats are ordered by `<`; NaN inputs leave the result unspecified.
+
+// Largest input sort_network() accepts.
+inline constexpr size_t kSortNetworkMaxSize = 64;
+
+// True when the kernels below run on SIMD registers rather than scalars.
+#if defined(__AVX2__)
+inline constexpr bool kSortNetworkVectorized = true;
+#else
+inline constexpr bool kSortNetworkVectorized = false;
+#endif
+
+// Element types with a sorting-network kernel.
+template <typename T>
+inline constexpr bool has_sort_network =
+    std::is_same_v<T, int32_t> || std::is_same_v<T, float> ||
+    std::is_same_v<T, int64_t>;
+
+namespace sort_network_detail {
+
+// Padding value that sorts after every real element.
+template <typename T> constexpr T pad_value() {
+  if constexpr (std::numeric_limits<T>::has_infinity)
+    return std::numeric_limits<T>::infinity();
+  else
+    return std::numeric_limits<T>::max();
+}
+
+// The network uses the "flip" formulation of bitonic sort: every
+// compare-exchange puts the minimum at the lower index, so no direction bits
+// are needed. For each block size k = 2, 4, ..., N:
+//   flip:   element i of the lower half of a k-block meets element k-1-i
+//   clean:  for j = k/4 .. 1, element i meets element i+j (when i & j == 0)
+
+template <typename T, size_t N> void bitonic_scalar(T *buf) {
+  for (size_t k = 2; k <= N; k <<= 1) {
+    for (size_t base = 0; base < N; base += k) {
+      for (size_t i = 0; i < k / 2; ++i) {
+        T a = buf[base + i], b = buf[base + k - 1 - i];
+        buf[base + i] = std::min(a, b);
+        buf[base + k - 1 - i] = std::max(a, b);
+      }
+    }
+    for (size_t j = k / 4; j >= 1; j >>= 1) {
+      for (size_t i = 0; i < N; ++i) {
+        if (i & j)
+          continue;
+        T a = buf[i], b = buf[i + j];
+        buf[i] = std::min(a, b);
+        buf[i + j] = std::max(a, b);
+      }
+    }
+  }
+}
+
+#if defined(__AVX2__)
+
+// permutevar8x32 index vectors: kXorIndex32[d][lane] = lane ^ d.
+alignas(32) inline constexpr int32_t kXorIndex32[8][8] = {
+    {0, 1, 2, 3, 4, 5, 6, 7}, {1, 0, 3, 2, 5, 4, 7, 6},
+    {2, 3, 0, 1, 6, 7, 4, 5}, {3, 2, 1, 0, 7, 6, 5, 4},
+    {4, 5, 6, 7, 0, 1, 2, 3}, {5, 4, 7, 6, 1, 0, 3, 2},
+    {6, 7, 4, 5, 2, 3, 0, 1}, {7, 6, 5, 4, 3, 2, 1, 0}};
+
+// The same permutation for 4 x 64-bit lanes, expressed as 32-bit halves.
+alignas(32) inline constexpr int32_t kXorIndex64[4][8] = {
+    {0, 1, 2, 3, 4, 5, 6, 7},
+    {2, 3, 0, 1, 6, 7, 4, 5},
+    {4, 5, 6, 7, 0, 1, 2, 3},
+    {6, 7, 4, 5, 2, 3, 0, 1}};
+
+// All-ones in the 32-bit lanes whose index has the given bit set.
+alignas(32) inline constexpr int32_t kLaneBit32[5][8] = {
+    {0, 0, 0, 0, 0, 0, 0, 0},
+    {0, -1, 0, -1, 0, -1, 0, -1},  // bit 1
+    {0, 0, -1, -1, 0, 0, -1, -1},  // bit 2
+    {0, 0, 0, 0, 0, 0, 0, 0},      // unused
+    {0, 0, 0, 0, -1, -1, -1, -1}}; // bit 4
+
+alignas(32) inline constexpr int32_t kLaneBit64[3][8] = {
+    {0, 0, 0, 0, 0, 0, 0, 0},
+    {0, 0, -1, -1, 0, 0, -1, -1},  // bit 1
+    {0, 0, 0, 0, -1, -1, -1, -1}}; // bit 2
+
+inline __m256i load_const(const int32_t *p) {
+  return _mm256_load_si256(reinterpret_cast<const __m256i *>(p));
+}
+
+struct OpsI32 {
+  using scalar = int32_t;
+  using vec = __m256i;
+  static constexpr size_t W = 8;
+  static vec load(const scalar *p) {
+    return _mm256_load_si256(reinterpret_cast<const __m256i *>(p));
+  }
+  static void store(scalar *p, vec v) {
+    _mm256_store_si256(reinterpret_cast<__m256i *>(p), v);
+  }
+  static vec min(vec a, vec b) { return _mm256_min_epi32(a, b); }
+  static vec max(vec a, vec b) { return _mm256_max_epi32(a, b); }
+  static vec xor_lanes(vec v, size_t d) {
+    return _mm256_permutevar8x32_epi32(v, load_const(kXorIndex32[d]));
+  }
+  // Lanes whose index has `bit` set take `hi`, the rest take `lo`.
+  static vec select(vec lo, vec hi, size_t bit) {
+    return _mm256_blendv_epi8(lo, hi, load_const(kLaneBit32[bit]));
+  }
+};
+
+struct OpsF32 {
+  using scalar = float;
+  using vec = __m256;
+  static constexpr size_t W = 8;
+  static vec load(const scalar *p) { return _mm256_load_ps(p); }
+  static void store(scalar *p, vec v) { _mm256_store_ps(p, v); }
+  static vec min(vec a, vec b) { return _mm256_min_ps(a, b); }
+  static vec max(vec a, vec b) { return _mm256_max_ps(a, b); }
+  static vec xor_lanes(vec v, size_t d) {
+    return _mm256_permutevar8x32_ps(v, load_const(kXorIndex32[d]));
+  }
+  static vec select(vec lo, vec hi, size_t bit) {
+    return _mm256_blendv_ps(lo, hi,
+                            _mm256_castsi256_ps(load_const(kLaneBit32[bit])));
+  }
+};
+
+struct OpsI64 {
+  using scalar = int64_t;
+  using vec = __m256i;
+  static constexpr size_t W = 4;
+  static vec load(const scalar *p) {
+    return _mm256_load_si256(reinterpret_cast<const __m256i *>(p));
+  }
+  static void store(scalar *p, vec v) {
+    _mm256_store_si256(reinterpret_cast<__m256i *>(p), v);
+  }
+  // AVX2 has no 64-bit min/max; build them from a compare and a blend.
+  static vec min(vec a, vec b) {
+    return _mm256_blendv_epi8(a, b, _mm256_cmpgt_epi64(a, b));
+  }
+  static vec max(vec a, vec b) {
+    return _mm256_blendv_epi8(b, a, _mm256_cmpgt_epi64(a, b));
+  }
+  static vec xor_lanes(vec v, size_t d) {
+    return _mm256_permutevar8x32_epi32(v, load_const(kXorIndex64[d]));
+  }
+  static vec select(vec lo, vec hi, size_t bit) {
+    return _mm256_blendv_epi8(lo, hi, load_const(kLaneBit64[bit]));
+  }
+};
+
+template <typename Ops, size_t N>
+void bitonic_vector(typename Ops::scalar *buf) {
+  using vec = typename Ops::vec;
+  constexpr size_t W = Ops::W;
+  static_assert(N % W == 0, "network size must be a multiple of the lanes");
+
+  for (size_t k = 2; k <= N; k <<= 1) {
+    // Flip stage.
+    if (k <= W) {
+      // Both ends of every pair share a register: lane i meets lane i^(k-1).
+      for (size_t r = 0; r < N; r += W) {
+        vec v = Ops::load(buf + r);
+        vec p = Ops::xor_lanes(v, k - 1);
+        Ops::store(buf + r, Ops::select(Ops::min(v, p), Ops::max(v, p), k / 2));
+      }
+    } else {
+      // Register t of the lower half meets the lane-reversed mirror register.
+      for (size_t base = 0; base < N; base += k) {
+        for (size_t t = 0; t < k / (2 * W); ++t) {
+          typename Ops::scalar *pa = buf + base + t * W;
+          typename Ops::scalar *pb = buf + base + k - (t + 1) * W;
+          vec a = Ops::load(pa);
+          vec b = Ops::xor_lanes(Ops::load(pb), W - 1);
+          Ops::store(pa, Ops::min(a, b));
+          Ops::store(pb, Ops::xor_lanes(Ops::max(a, b), W - 1));
+        }
+      }
+    }
+    // Half-cleaner stages.
+    for (size_t j = k / 4; j >= 1; j >>= 1) {
+      if (j >= W) {
+        for (size_t i = 0; i < N; i += W) {
+          if (i & j)
+            continue;
+          vec a = Ops::load(buf + i);
+          vec b = Ops::load(buf + i + j);
+          Ops::store(buf + i, Ops::min(a, b));
+          Ops::store(buf + i + j, Ops::max(a, b));
+        }
+      } else {
+        for (size_t r = 0; r < N; r += W) {
+          vec v = Ops::load(buf + r);
+          vec p = Ops::xor_lanes(v, j);
+          Ops::store(buf + r, Ops::select(Ops::min(v, p), Ops::max(v, p), j));
+        }
+      }
+    }
+  }
+}
+
+template <typename T> struct VectorOps;
+template <> struct VectorOps<int32_t> { using type = OpsI32; };
+template <> struct VectorOps<float> { using type = OpsF32; };
+template <> struct VectorOps<int64_t> { using type = OpsI64; };
+
+#endif // __AVX2__
+
+template <typename T, size_t N> void bitonic(T *buf) {
+#if defined(__AVX2__)
+  bitonic_vector<typename VectorOps<T>::type, N>(buf);
+#else
+  bitonic_scalar<T, N>(buf);
+#endif
+}
+
+} // namespace sort_network_detail
+
+// Sorts exactly N elements in place, N in {8, 16, 32, 64}.
+template <size_t N, typename T> void sort_network_fixed(T *data) {
+  static_assert(has_sort_network<T>, "no sorting network for this type");
+  static_assert(N == 8 || N == 16 || N == 32 || N == 64,
+                "sorting networks come in sizes 8, 16, 32 and 64");
+  alignas(32) T buf[N];
+  std::copy(data, data + N, buf);
+  sort_network_detail::bitonic<T, N>(buf);
+  std::copy(buf, buf + N, data);
+}
+
+// Sorts n <= kSortNetworkMaxSize elements in place. The input is padded up to
+// the next network size with values that sort last.
+template <typename T> void sort_network(T *data, size_t n) {
+  static_assert(has_sort_network<T>, "no sorting network for this type");
+  if (n > kSortNetworkMaxSize)
+    throw std::length_error("sort_network handles at most 64 elements.");
+  if (n < 2)
+    return;
+
+  alignas(32) T buf[kSortNetworkMaxSize];
+  std::copy(data, data + n, buf);
+  size_t padded = std::max<size_t>(8, std::bit_ceil(n));
+  std::fill(buf + n, buf + padded, sort_network_detail::pad_value<T>());
+  switch (padded) {
+  case 8:
+    sort_network_detail::bitonic<T, 8>(buf);
+    break;
+  case 16:
+    sort_network_detail::bitonic<T, 16>(buf);
+    break;
+  case 32:
+    sort_network_detail::bitonic<T, 32>(buf);
+    break;
+  default:
+    sort_network_detail::bitonic<T, 64>(buf);
+    break;
+  }
+  std::copy(buf, buf + n, data);
+}
+
+#endif // SORT_NETWORK_H
@@ -0,0 +1,291 @@
+//
+//  string_kernels.h
+//  DSA-Project
+//
+//  Created by richie on 10/19/26.
+//
+
+#ifndef STRING_KERNELS_H
+#define STRING_KERNELS_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#if defined(__AVX2__) || defined(__SSSE3__)
+#include <immintrin.h>
+#endif
+
+// Byte kernels behind the functions in strings.h, for buffers of any size.
+//
+// reverse_bytes and mirrored_bytes_equal (behind is_palindrome_bytes) work
+// from both ends at once: with AVX2 they load 32-byte blocks from the front
+// and the back, reverse the byte order of each block with a shuffle (plus a
+// lane swap), and store or compare whole blocks; with SSSE3 they do the same
+// on 16-byte blocks, which also finishes the AVX2 loop. Whatever is left in
+// the middle, less than one block from each end, goes through the scalar
+// loops, which are also the whole implementation on other targets.
+//
+// byte_histogram counts every byte value in one pass, for the duplicate and
+// anagram functions. Counting raw bytes and folding case afterwards
+// (fold_ascii_case_counts) costs 26 additions instead of a fold per byte.
+//
+// Case folding is ASCII only: 'A'-'Z' compare equal to 'a'-'z', and every
+// other byte, including each byte of a multi-byte UTF-8 sequence, compares
+// as itself.
+
+inline char fold_ascii_case(char c) {
+  return (c >= 'A' && c <= 'Z') ? static_cast<char>(c | 0x20) : c;
+}
+
+inline void reverse_bytes_scalar(char *data, size_t n) {
+  if (n < 2)
+    return;
+  size_t low = 0, high = n - 1;
+  while (low < high)
+    std::swap(data[low++], data[high--]);
+}
+
+inline bool is_palindrome_bytes_scalar(const char *data, size_t n,
+                                       bool ignore_ascii_case = false) {
+  if (n < 2)
+    return true;
+  size_t low = 0, high = n - 1;
+  while (low < high) {
+    char a = data[low++], b = data[high--];
+    if (ignore_ascii_case ? fold_ascii_case(a) != fold_ascii_case(b)
+                          : a != b)
+      return false;
+  }
+  return true;
+}
+
+namespace string_kernels_detail {
+
+#if defined(__SSSE3__)
+
+inline __m128i reverse16(__m128i v) {
+  const __m128i order =
+      _mm_setr_epi8(15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+  return _mm_shuffle_epi8(v, order);
+}
+
+// ORs 0x20 into the bytes that are 'A'-'Z'. Bytes >= 0x80 are negative in
+// the signed compares, so they are never treated as letters.
+inline __m128i fold16(__m128i v) {
+  __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('A' - 1)),
+                                _mm_cmplt_epi8(v, _mm_set1_epi8('Z' + 1)));
+  return _mm_or_si128(v, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+}
+
+inline __m128i load16(const char *p) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+}
+
+inline void store16(char *p, __m128i v) {
+  _mm_storeu_si128(reinterpret_cast<__m128i *>(p), v);
+}
+
+#endif
+
+#if defined(__AVX2__)
+
+// pshufb only shuffles within each 128-bit lane, so the bytes are reversed
+// per lane and then the two lanes are swapped.
+inline __m256i reverse32(__m256i v) {
+  const __m256i order = _mm256_setr_epi8(
+      15, 14, 13, 12, 11, 10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11,
+      10, 9, 8, 7, 6, 5, 4, 3, 2, 1, 0);
+  return _mm256_permute4x64_epi64(_mm256_shuffle_epi8(v, order), 0x4E);
+}
+
+inline __m256i fold32(__m256i v) {
+  __m256i upper =
+      _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8('A' - 1)),
+                       _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), v));
+  return _mm256_or_si256(v, _mm256_and_si256(upper, _mm256_set1_epi8(0x20)));
+}
+
+inline __m256i load32(const char *p) {
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+}
+
+inline void store32(char *p, __m256i v) {
+  _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v);
+}
+
+#endif
+
+} // namespace string_kernels_detail
+
+// Reverses data[0, n) in place.
+inline void reverse_bytes(char *data, size_t n) {
+  using namespace string_kernels_detail;
+  size_t low = 0, high = n;
+#if defined(__AVX2__)
+  while (high - low >= 64) {
+    __m256i front = load32(data + low), back = load32(data + high - 32);
+    store32(data + low, reverse32(back));
+    store32(data + high - 32, reverse32(front));
+    low += 32;
+    high -= 32;
+  }
+#endif
+#if defined(__SSSE3__)
+  while (high - low >= 32) {
+    __m128i front = load16(data + low), back = load16(data + high - 16);
+    store16(data + low, reverse16(back));
+    store16(data + high - 16, reverse16(front));
+    low += 16;
+    high -= 16;
+  }
+#endif
+  reverse_bytes_scalar(data + low, high - low);
+}
+
+// Whether front[i] == back[n - 1 - i] for every i < n, optionally ignoring
+// ASCII case: front[0, n) read forwards matches back[0, n) read backwards.
+// Stops at the first mismatching block.
+inline bool mirrored_bytes_equal(const char *front, const char *back, size_t n,
+                                 bool ignore_ascii_case = false) {
+  using namespace string_kernels_detail;
+  size_t low = 0, high = n;
+#if defined(__AVX2__)
+  for (; low + 32 <= n; low += 32, high -= 32) {
+    __m256i a = load32(front + low);
+    __m256i b = reverse32(load32(back + high - 32));
+    if (ignore_ascii_case) {
+      a = fold32(a);
+      b = fold32(b);
+    }
+    if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, b)) != -1)
+      return false;
+  }
+#endif
+#if defined(__SSSE3__)
+  for (; low + 16 <= n; low += 16, high -= 16) {
+    __m128i a = load16(front + low);
+    __m128i b = reverse16(load16(back + high - 16));
+    if (ignore_ascii_case) {
+      a = fold16(a);
+      b = fold16(b);
+    }
+    if (_mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) != 0xFFFF)
+      return false;
+  }
+#endif
+  for (; low < n; ++low) {
+    char a = front[low], b = back[--high];
+    if (ignore_ascii_case ? fold_ascii_case(a) != fold_ascii_case(b) : a != b)
+      return false;
+  }
+  return true;
+}
+
+// Whether data[0, n) reads the same backwards, optionally ignoring ASCII
+// case: its first half mirrors its second.
+inline bool is_palindrome_bytes(const char *data, size_t n,
+                                bool ignore_ascii_case = false) {
+  return mirrored_bytes_equal(data, data + (n - n / 2), n / 2,
+                              ignore_ascii_case);
+}
+
+// --- Byte histograms ---
+
+// Occurrences of each byte value, indexed by unsigned char.
+using ByteHistogram = std::array<uint64_t, 256>;
+
+// Below this length the interleaved tables cost more to clear and sum than
+// they save, and bytes are counted straight into the result.
+inline constexpr size_t kHistogramInterleaveMin = 256;
+
+// Bytes counted into the 32-bit interleaved tables before they are added
+// into the 64-bit result. Each table gets a quarter of the bytes, so no
+// counter can pass 2^28.
+inline constexpr size_t kHistogramFlushBytes = size_t(1) << 30;
+
+// Adds the bytes of data[0, n) to `counts`. Consecutive bytes usually repeat
+// on text, and incrementing one counter table would make each update wait
+// for the store before it. Four tables, with bytes assigned round-robin,
+// keep four independent chains in flight; eight bytes are loaded per
+// iteration and split with shifts.
+inline void add_byte_histogram(const char *data, size_t n,
+                               ByteHistogram &counts) {
+  const auto *bytes = reinterpret_cast<const unsigned char *>(data);
+  if (n < kHistogramInterleaveMin) {
+    for (size_t i = 0; i < n; ++i)
+      ++counts[bytes[i]];
+    return;
+  }
+  uint32_t tables[4][256];
+  for (size_t start = 0; start < n; start += kHistogramFlushBytes) {
+    const size_t end = start + std::min(n - start, kHistogramFlushBytes);
+    std::memset(tables, 0, sizeof(tables));
+    size_t i = start;
+    for (; i + 8 <= end; i += 8) {
+      uint64_t word;
+      std::memcpy(&word, bytes + i, 8);
+      ++tables[0][word & 0xFF];
+      ++tables[1][(word >> 8) & 0xFF];
+      ++tables[2][(word >> 16) & 0xFF];
+      ++tables[3][(word >> 24) & 0xFF];
+      ++tables[0][(word >> 32) & 0xFF];
+      ++tables[1][(word >> 40) & 0xFF];
+      ++tables[2][(word >> 48) & 0xFF];
+      ++tables[3][word >> 56];
+    }
+    for (; i < end; ++i)
+      ++tables[0][bytes[i]];
+    for (size_t b = 0; b < 256; ++b)
+      counts[b] += uint64_t(tables[0][b]) + tables[1][b] + tables[2][b] +
+                   tables[3][b];
+  }
+}
+
+inline ByteHistogram byte_histogram(const char *data, size_t n) {
+  ByteHistogram counts{};
+  add_byte_histogram(data, n, counts);
+  return counts;
+}
+
+// Moves the counts of 'A'-'Z' onto 'a'-'z'.
+inline void fold_ascii_case_counts(ByteHistogram &counts) {
+  for (unsigned char c = 'A'; c <= 'Z'; ++c) {
+    counts[c | 0x20] += counts[c];
+    counts[c] = 0;
+  }
+}
+
+// Clears every count except those of 'a'-'z' and 'A'-'Z'.
+inline void keep_ascii_letter_counts(ByteHistogram &counts) {
+  for (size_t b = 0; b < 256; ++b) {
+    char c = fold_ascii_case(static_cast<char>(b));
+    if (c < 'a' || c > 'z')
+      counts[b] = 0;
+  }
+}
+
+// Whether two histograms match, comparing four counters per instruction
+// with AVX2 and with no early exit: 2 KiB is cheaper to compare whole than
+// to branch on.
+inline bool histograms_equal(const ByteHistogram &a, const ByteHistogram &b) {
+#if defined(__AVX2__)
+  __m256i diff = _mm256_setzero_si256();
+  for (size_t i = 0; i < 256; i += 4) {
+    __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&a[i]));
+    __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(&b[i]));
+    diff = _mm256_or_si256(diff, _mm256_xor_si256(va, vb));
+  }
+  return _mm256_testz_si256(diff, diff) != 0;
+#else
+  uint64_t diff = 0;
+  for (size_t i = 0; i < 256; ++i)
+    diff |= a[i] ^ b[i];
+  return diff == 0;
+#endif
+}
+
+#endif // STRING_KERNELS_H
@@ -0,0 +1,518 @@
+//
+//  string_search.h
+//  DSA-Project
+//
+//  Created by richie on 10/19/26.
+//
+
+#ifndef STRING_SEARCH_H
+#define STRING_SEARCH_H
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <initializer_list>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "result_sink.h"
+
+// Substring search, one pattern at a time or a dictionary at once.
+//
+// StringSearcher prepares a pattern once and picks a method by its length:
+//
+//   - Filter (up to kSearchFilterMaxPattern bytes): compares the pattern's
+//     first and last bytes against 32 (AVX2) or 16 (SSE2) text positions per
+//     step and checks the rest only where both match. On text, a
+//     first-and-last pair is much rarer than a first byte alone, which is
+//     all memchr-based searches can filter on, and checking a candidate
+//     costs at most one short memcmp.
+//   - Horspool takes the same range on targets without SSE2, where the
+//     filter is a byte loop: Boyer–Moore–Horspool tests the last byte of
+//     each window and skips ahead by up to the pattern length.
+//   - Two-Way (longer patterns): Crochemore–Perrin, linear time and O(1)
+//     extra memory whatever the input. The filter and Horspool are
+//     O(n·m) on repetitive text, and the cost of a bad case grows with the
+//     pattern length. A Horspool-style skip on each window's last byte
+//     keeps it fast on ordinary text.
+//
+// find_substring, find_all_substrings and count_substrings are the
+// one-shot forms. Matches may overlap: "aa" occurs three times in "aaaa".
+// An empty pattern matches at every position, 0 through text.size(), as
+// with std::string::find.
+//
+// AhoCorasick finds every occurrence of any of many patterns in one pass
+// over the text, for dictionaries where one search per pattern would read
+// the text once per pattern.
+
+inline constexpr size_t kSearchFilterMaxPattern = 64;
+
+enum class SearchMethod { Auto, Filter, Horspool, TwoWay };
+
+namespace string_search_detail {
+
+inline const unsigned char *Bytes(std::string_view s) {
+  return reinterpret_cast<const unsigned char *>(s.data());
+}
+
+// Each kernel below reports match positions >= from to on_match, in
+// increasing order, and returns false if on_match stopped it.
+
+inline bool Matches(const char *window, std::string_view pattern) {
+  // The first and last bytes are already known to match.
+  return pattern.size() <= 2 ||
+         std::memcmp(window + 1, pattern.data() + 1, pattern.size() - 2) == 0;
+}
+
+template <typename Fn>
+bool ScanFilter(std::string_view text, std::string_view pattern, size_t from,
+                Fn &on_match) {
+  const size_t n = text.size(), m = pattern.size();
+  const char *t = text.data();
+  size_t i = from;
+  if (m == 1) {
+    while (i < n) {
+      const void *hit = std::memchr(t + i, pattern[0], n - i);
+      if (!hit)
+        return true;
+      i = static_cast<const char *>(hit) - t;
+      if (!on_match(i))
+        return false;
+      ++i;
+    }
+    return true;
+  }
+#if defined(__AVX2__)
+  const __m256i first32 = _mm256_set1_epi8(pattern.front());
+  const __m256i last32 = _mm256_set1_epi8(pattern.back());
+  for (; i + m - 1 + 32 <= n; i += 32) {
+    __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(t + i));
+    __m256i b = _mm256_loadu_si256(
+        reinterpret_cast<const __m256i *>(t + i + m - 1));
+    auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(
+        _mm256_cmpeq_epi8(a, first32), _mm256_cmpeq_epi8(b, last32))));
+    for (; mask; mask &= mask - 1) {
+      size_t at = i + std::countr_zero(mask);
+      if (Matches(t + at, pattern) && !on_match(at))
+        return false;
+    }
+  }
+#endif
+#if defined(__SSE2__)
+  const __m128i first16 = _mm_set1_epi8(pattern.front());
+  const __m128i last16 = _mm_set1_epi8(pattern.back());
+  for (; i + m - 1 + 16 <= n; i += 16) {
+    __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(t + i));
+    __m128i b =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(t + i + m - 1));
+    auto mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(
+        _mm_cmpeq_epi8(a, first16), _mm_cmpeq_epi8(b, last16))));
+    for (; mask; mask &= mask - 1) {
+      size_t at = i + std::countr_zero(mask);
+      if (Matches(t + at, pattern) && !on_match(at))
+        return false;
+    }
+  }
+#endif
+  for (; i + m <= n; ++i) {
+    if (t[i] == pattern.front() && t[i + m - 1] == pattern.back() &&
+        Matches(t + i, pattern) && !on_match(i))
+      return false;
+  }
+  return true;
+}
+
+// For each byte, the distance from its last occurrence in pattern[0, end)
+// to the pattern's last position, or the pattern length if it does not
+// occur there: how far a window may move when that byte is under the
+// pattern's last position.
+using ShiftTable = std::array<size_t, 256>;
+
+inline ShiftTable MakeShiftTable(std::string_view pattern, size_t end) {
+  ShiftTable shift;
+  const size_t m = pattern.size();
+  shift.fill(m);
+  for (size_t i = 0; i < end; ++i)
+    shift[static_cast<unsigned char>(pattern[i])] = m - 1 - i;
+  return shift;
+}
+
+template <typename Fn>
+bool ScanHorspool(std::string_view text, std::string_view pattern,
+                  const ShiftTable &shift, size_t from, Fn &on_match) {
+  const size_t n = text.size(), m = pattern.size();
+  const unsigned char *t = Bytes(text);
+  const unsigned char last = static_cast<unsigned char>(pattern.back());
+  for (size_t i = from; i + m <= n;) {
+    unsigned char c = t[i + m - 1];
+    if (c == last && std::memcmp(t + i, pattern.data(), m - 1) == 0 &&
+        !on_match(i))
+      return false;
+    i += shift[c];
+  }
+  return true;
+}
+
+// The critical factorization of a pattern: the pattern is split before
+// `split`, and `period` is a safe shift after a full match.
+struct TwoWayFactorization {
+  size_t split = 0;
+  size_t period = 1;
+  bool periodic = false; // the left part recurs `period` bytes later
+};
+
+// Start and period of the maximal suffix of x[0, m) under the byte order,
+// or under the reversed order.
+inline std::pair<size_t, size_t> MaximalSuffix(const unsigned char *x,
+                                               size_t m, bool reversed) {
+  size_t start = 0, j = 1, k = 0, period = 1;
+  while (j + k < m) {
+    unsigned char a = x[j + k], b = x[start + k];
+    if (a == b) {
+      if (++k == period) {
+        j += period;
+        k = 0;
+      }
+    } else if ((a < b) != reversed) {
+      j += k + 1;
+      k = 0;
+      period = j - start;
+    } else {
+      start = j++;
+      k = 0;
+      period = 1;
+    }
+  }
+  return {start, period};
+}
+
+inline TwoWayFactorization MakeTwoWay(std::string_view pattern) {
+  const unsigned char *x = Bytes(pattern);
+  const size_t m = pattern.size();
+  auto [s1, p1] = MaximalSuffix(x, m, false);
+  auto [s2, p2] = MaximalSuffix(x, m, true);
+  TwoWayFactorization f;
+  f.split = std::max(s1, s2);
+  f.period = s1 > s2 ? p1 : p2;
+  f.periodic = f.split + f.period <= m &&
+               std::memcmp(x, x + f.period, f.split) == 0;
+  // Otherwise the pattern's period is longer than either part, which makes
+  // this a safe shift.
+  if (!f.periodic)
+    f.period = std::max(f.split, m - f.split + 1);
+  return f;
+}
+
+// Before comparing, each window's last byte is looked up in the shift table
+// as in Horspool, which skips most windows on text; the comparisons keep
+// their linear bound.
+template <typename Fn>
+bool ScanTwoWay(std::string_view text, std::string_view pattern,
+                const TwoWayFactorization &f, const ShiftTable &shift,
+                size_t from, Fn &on_match) {
+  const size_t n = text.size(), m = pattern.size();
+  const unsigned char *t = Bytes(text), *x = Bytes(pattern);
+  // `memory`: in the periodic case, how many leading bytes of the window
+  // are known to match from the previous alignment.
+  size_t memory = 0;
+  for (size_t j = from; j + m <= n;) {
+    if (size_t skip = shift[t[j + m - 1]]) {
+      j += std::max(skip, memory);
+      memory = 0;
+      continue;
+    }
+    // Right part, left to right.
+    size_t i = std::max(f.split, memory);
+    while (i < m && x[i] == t[j + i])
+      ++i;
+    if (i < m) {
+      j += i - f.split + 1;
+      memory = 0;
+      continue;
+    }
+    // Left part, right to left, down to what is already known.
+    size_t low = f.periodic ? memory : 0;
+    size_t k = f.split;
+    while (k > low && x[k - 1] == t[j + k - 1])
+      --k;
+    if (k <= low && !on_match(j))
+      return false;
+    j += f.period;
+    memory = f.periodic ? m - f.period : 0;
+  }
+  return true;
+}
+
+} // namespace string_search_detail
+
+// A pattern prepared for repeated searches.
+class StringSearcher {
+public:
+  explicit StringSearcher(std::string_view pattern,
+                          SearchMethod method = SearchMethod::Auto)
+      : pattern(pattern), method(method) {
+    using namespace string_search_detail;
+    if (this->method == SearchMethod::Auto) {
+#if defined(__SSE2__)
+      const SearchMethod short_method = SearchMethod::Filter;
+#else
+      const SearchMethod short_method = SearchMethod::Horspool;
+#endif
+      this->method = pattern.size() <= kSearchFilterMaxPattern
+                         ? short_method
+                         : SearchMethod::TwoWay;
+    }
+    // Horspool shifts on the bytes before the last one, so a window always
+    // moves; Two-Way also sees 0 for a matching last byte.
+    if (this->method == SearchMethod::Horspool && !pattern.empty())
+      shift = MakeShiftTable(pattern, pattern.size() - 1);
+    if (this->method == SearchMethod::TwoWay && !pattern.empty()) {
+      shift = MakeShiftTable(pattern, pattern.size());
+      factorization = MakeTwoWay(pattern);
+    }
+  }
+
+  // The method in use; never Auto.
+  SearchMethod Method() const { return method; }
+  std::string_view Pattern() const { return pattern; }
+
+  // Calls fn(position) for each match at or after `from`, in order. fn may
+  // return bool; returning false stops.
+  template <typename Fn>
+  void ForEachMatch(std::string_view text, Fn &&fn, size_t from = 0) const {
+    using namespace string_search_detail;
+    auto on_match = [&](size_t at) { return invoke_sink(fn, at); };
+    if (pattern.empty()) {
+      for (size_t i = from; i <= text.size(); ++i)
+        if (!on_match(i))
+          return;
+      return;
+    }
+    switch (method) {
+    case SearchMethod::Horspool:
+      ScanHorspool(text, pattern, shift, from, on_match);
+      break;
+    case SearchMethod::TwoWay:
+      ScanTwoWay(text, pattern, factorization, shift, from, on_match);
+      break;
+    default:
+      ScanFilter(text, pattern, from, on_match);
+      break;
+    }
+  }
+
+  // First match at or after `from`, or std::string_view::npos.
+  size_t Find(std::string_view text, size_t from = 0) const {
+    size_t found = std::string_view::npos;
+    if (from > text.size())
+      return found;
+    ForEachMatch(
+        text,
+        [&](size_t at) {
+          found = at;
+          return false;
+        },
+        from);
+    return found;
+  }
+
+  std::vector<size_t> FindAll(std::string_view text) const {
+    std::vector<size_t> positions;
+    ForEachMatch(text, [&](size_t at) { positions.push_back(at); });
+    return positions;
+  }
+
+  size_t Count(std::string_view text) const {
+    size_t count = 0;
+    ForEachMatch(text, [&](size_t) { ++count; });
+    return count;
+  }
+
+private:
+  std::string pattern;
+  SearchMethod method;
+  string_search_detail::ShiftTable shift{};
+  string_search_detail::TwoWayFactorization factorization;
+};
+
+inline size_t find_substring(std::string_view text, std::string_view pattern,
+                             size_t from = 0) {
+  return StringSearcher(pattern).Find(text, from);
+}
+
+inline std::vector<size_t> find_all_substrings(std::string_view text,
+                                               std::string_view pattern) {
+  return StringSearcher(pattern).FindAll(text);
+}
+
+inline size_t count_substrings(std::string_view text,
+                               std::string_view pattern) {
+  return StringSearcher(pattern).Count(text);
+}
+
+// --- Aho–Corasick ---
+
+// One occurrence of dictionary pattern `pattern` starting at `position`.
+struct PatternMatch {
+  size_t pattern;
+  size_t position;
+  bool operator==(const PatternMatch &) const = default;
+};
+
+// A dictionary of patterns compiled into one automaton. The bytes that
+// occur in the patterns get dense class numbers, every other byte shares
+// class 0, and each state stores its full transition row over the classes,
+// failure links already followed. Scanning is then one table lookup per
+// text byte, with memory proportional to states x distinct pattern bytes
+// rather than states x 256.
+class AhoCorasick {
+public:
+  // Throws std::invalid_argument on an empty pattern, which would match
+  // everywhere.
+  explicit AhoCorasick(std::span<const std::string> patterns) {
+    Build(patterns);
+  }
+  AhoCorasick(std::initializer_list<std::string> patterns) {
+    Build(std::span<const std::string>(patterns.begin(), patterns.size()));
+  }
+
+  size_t PatternCount() const { return lengths.size(); }
+  size_t StateCount() const { return output.size(); }
+
+  // Calls fn(PatternMatch) for each occurrence, ordered by end position;
+  // matches ending at the same byte come longest first, and equal patterns
+  // in dictionary order. fn may return bool; returning false stops.
+  template <typename Fn> void ForEachMatch(std::string_view text, Fn &&fn) const {
+    const unsigned char *t = string_search_detail::Bytes(text);
+    uint32_t state = 0;
+    for (size_t i = 0; i < text.size(); ++i) {
+      state = next[state * classes + byte_class[t[i]]];
+      for (uint32_t s = output[state]; s != kNone; s = output_link[s]) {
+        for (uint32_t p = terminal[s]; p != kNone; p = same_pattern[p]) {
+          if (!invoke_sink(fn, PatternMatch{p, i + 1 - lengths[p]}))
+            return;
+        }
+      }
+    }
+  }
+
+  std::vector<PatternMatch> FindAll(std::string_view text) const {
+    std::vector<PatternMatch> matches;
+    ForEachMatch(text, [&](PatternMatch m) { matches.push_back(m); });
+    return matches;
+  }
+
+  size_t Count(std::string_view text) const {
+    size_t count = 0;
+    ForEachMatch(text, [&](PatternMatch) { ++count; });
+    return count;
+  }
+
+  // Whether any pattern occurs; stops at the first.
+  bool ContainsAny(std::string_view text) const {
+    bool found = false;
+    ForEachMatch(text, [&](PatternMatch) {
+      found = true;
+      return false;
+    });
+    return found;
+  }
+
+private:
+  static constexpr uint32_t kNone = UINT32_MAX;
+
+  std::array<uint32_t, 256> byte_class{};
+  size_t classes = 1;
+  std::vector<uint32_t> next;        // state * classes + class -> state
+  std::vector<uint32_t> terminal;    // first pattern ending here, or kNone
+  std::vector<uint32_t> output;      // nearest state (itself included) on
+                                     // the failure chain that ends a pattern
+  std::vector<uint32_t> output_link; // the next such state after this one
+  std::vector<uint32_t> same_pattern; // next pattern equal to this one
+  std::vector<size_t> lengths;
+
+  void Build(std::span<const std::string> patterns) {
+    if (patterns.size() >= kNone)
+      throw std::length_error("too many Aho–Corasick patterns");
+    for (const std::string &pattern : patterns) {
+      if (pattern.empty())
+        throw std::invalid_argument("Aho–Corasick patterns must be non-empty");
+      for (unsigned char c : pattern)
+        if (byte_class[c] == 0)
+          byte_class[c] = static_cast<uint32_t>(classes++);
+    }
+
+    // Trie over the classes; 0 in `next` means no edge yet (the root is
+    // never a child).
+    auto add_state = [&] {
+      next.resize(next.size() + classes, 0);
+      terminal.push_back(kNone);
+      return static_cast<uint32_t>(terminal.size() - 1);
+    };
+    add_state();
+    same_pattern.assign(patterns.size(), kNone);
+    std::vector<uint32_t> last_pattern; // tail of each state's equal list
+    for (size_t p = 0; p < patterns.size(); ++p) {
+      uint32_t state = 0;
+      for (unsigned char c : patterns[p]) {
+        uint32_t &edge = next[state * classes + byte_class[c]];
+        if (edge == 0) {
+          uint32_t child = add_state();
+          next[state * classes + byte_class[c]] = child;
+          state = child;
+        } else {
+          state = edge;
+        }
+      }
+      last_pattern.resize(terminal.size(), kNone);
+      if (terminal[state] == kNone)
+        terminal[state] = static_cast<uint32_t>(p);
+      else
+        same_pattern[last_pattern[state]] = static_cast<uint32_t>(p);
+      last_pattern[state] = static_cast<uint32_t>(p);
+      lengths.push_back(patterns[p].size());
+    }
+
+    // Breadth-first, so a state's failure target is finished before the
+    // state: missing edges copy the failure target's row, and the output
+    // chain extends the failure target's.
+    const size_t states = terminal.size();
+    std::vector<uint32_t> fail(states, 0);
+    output.assign(states, kNone);
+    output_link.assign(states, kNone);
+    std::deque<uint32_t> queue;
+    for (size_t c = 0; c < classes; ++c)
+      if (next[c] != 0)
+        queue.push_back(next[c]);
+    while (!queue.empty()) {
+      uint32_t state = queue.front();
+      queue.pop_front();
+      const uint32_t f = fail[state];
+      output_link[state] = output[f];
+      output[state] = terminal[state] != kNone ? state : output[f];
+      for (size_t c = 0; c < classes; ++c) {
+        uint32_t &edge = next[state * classes + c];
+        if (edge != 0) {
+          fail[edge] = next[f * classes + c];
+          queue.push_back(edge);
+        } else {
+          edge = next[f * classes + c];
+        }
+      }
+    }
+  }
+};
+
+#endif // STRING_SEARCH_H
@@ -6,20 +6,13 @@
 //
 
 #include "strings.h"
-#include <iostream>
-#include <unordered_map>
+#include "string_kernels.h"
+#include "utf8.h"
 #include <algorithm>
+#include <bit>
 #include <cctype>
 #include <cassert>
-
-char to_lower_ascii(char c) {
-    return static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
-}
-
-bool is_ascii_letter(char c) {
-    char lower = to_lower_ascii(c);
-    return lower >= 'a' && lower <= 'z';
-}
+#include <cstring>
 
 void perm_build_helper(const std::string& original, std::string& current_perm,
                        std::vector<bool>& used, size_t k,
@@ -98,121 +91,201 @@ std::vector<std::string> generate_permutations(const std::string& s) {
 }
 
 void reverse_string(std::string& s) {
-    if (s.empty()) return;
-    size_t low = 0, high = s.length() - 1;
-    while (low < high) {
-        std::swap(s[low], s[high]);
-        ++low;
-        --high;
-    }
+    // The kernel swaps whole blocks from both ends; see string_kernels.h.
+    reverse_bytes(s.data(), s.length());
 }
 
-bool is_palindrome(const std::string& s) {
-    if (s.empty()) return true;
-    size_t low = 0, high = s.length() - 1;
-    while (low < high) {
-        if (s[low] != s[high]) {
-            return false;
-        }
-        ++low;
-        --high;
-    }
-    return true;
+bool is_palindrome(const std::string& s, bool ignore_ascii_case) {
+    return is_palindrome_bytes(s.data(), s.length(), ignore_ascii_case);
 }
 
-void find_duplicates_hashing(const std::string& s) {
-    // Hashing counts every normalized character, then reports alphabetic keys
-    // whose count is greater than one.
-    std::unordered_map<char, int> freq_map;
-    for (char c : s) {
-        char normalized_char = to_lower_ascii(c);
-        freq_map[normalized_char]++;
-    }
-    
-    std::cout << "\nDuplicates Found: ";
-    for (const auto& pair : freq_map) {
-        // pair.first is the key, pair.second is its count (value)
-        if (pair.second > 1) {
-            // add a check to avoid reporting spaces or punctuation as duplicates.
-            if (is_ascii_letter(pair.first)) {
-                std::cout << "\nCharacter: '" << pair.first << "', Occurences: " << pair.second << std::endl;
-            }
-        }
-    }
+namespace {
+
+// Case-folded counts of every byte of s.
+ByteHistogram folded_histogram(const std::string& s) {
+    ByteHistogram counts = byte_histogram(s.data(), s.length());
+    fold_ascii_case_counts(counts);
+    return counts;
 }
 
-void find_duplicates_bitwise(const std::string& s) {
-    long long flags = 0;
-    long long duplicates = 0;
-    
-    // The bit-mask method stores one bit per lowercase ASCII letter.
-    for (char original_char : s) {
-        
-        if (!is_ascii_letter(original_char)) {
-            continue;
-        }
-        
-        char c = to_lower_ascii(original_char);
-        
-        // calculate how much to shift
-        long long mask = 1LL << (c - 'a');
-        
-        // check if letter's bti is already 'on' in our flags.
-        if ((flags & mask) > 0) {
-            
-            // it's a duplicate. Turn on its bit in the 'duplicates' field.
-            duplicates |= mask;
+} // namespace
+
+std::vector<CharCount> find_duplicates_hashing(const std::string& s) {
+    // The histogram is indexed by the byte itself, so it does the job of the
+    // old hash map without hashing; only letters are reported.
+    ByteHistogram counts = folded_histogram(s);
+    std::vector<CharCount> duplicates;
+    for (char c = 'a'; c <= 'z'; ++c) {
+        uint64_t count = counts[static_cast<unsigned char>(c)];
+        if (count > 1) {
+            duplicates.push_back({c, static_cast<size_t>(count)});
         }
-        // in either case, mark that we've seen this letter by turning its bits 'on'.
-        flags |= mask;
     }
-    
-    std::cout << "\nDuplicates found (bitwise method):\n" << std::endl;
-    bool any_duplicates_found = false;
+    return duplicates;
+}
+
+std::vector<CharCount> find_duplicates_bitwise(const std::string& s) {
+    // The bit-mask method stores one bit per lowercase ASCII letter, set when
+    // the letter's count is above one.
+    ByteHistogram counts = folded_histogram(s);
+    uint32_t duplicates = 0;
     for (size_t i = 0; i < 26; i++) {
-        long long mask = 1LL << i;
-        if ((duplicates & mask) > 0) {
-            std::cout << "'" << static_cast<char>('a' + i) << "' is a duplicate.\n" << std::endl;
-            any_duplicates_found = true;
-        }
+        duplicates |= static_cast<uint32_t>(counts['a' + i] > 1) << i;
     }
-    
-    if (!any_duplicates_found) {
-        std::cout << "No duplicate alphabetic characters found.\n" << std::endl;
+
+    std::vector<CharCount> result;
+    for (; duplicates != 0; duplicates &= duplicates - 1) {
+        size_t i = static_cast<size_t>(std::countr_zero(duplicates));
+        result.push_back({static_cast<char>('a' + i), static_cast<size_t>(counts['a' + i])});
     }
+    return result;
 }
 
 bool are_anagrams_hash(const std::string& s1, const std::string& s2) {
     if (s1.length() != s2.length()) return false;
-    std::unordered_map<char, int> freq_map;
-    for (char c : s1) freq_map[to_lower_ascii(c)]++;
-    for (char c: s2) freq_map[to_lower_ascii(c)]--;
-    for (const auto& pair : freq_map) if (pair.second != 0) return false;
-    return true;
+    return histograms_equal(folded_histogram(s1), folded_histogram(s2));
 }
 
 bool are_anagrams_bitwise(const std::string& s1, const std::string& s2) {
     if (s1.length() != s2.length()) return false;
 
-    long long char_counts[26] = {0};
+    ByteHistogram counts1 = folded_histogram(s1);
+    ByteHistogram counts2 = folded_histogram(s2);
+    keep_ascii_letter_counts(counts1);
+    keep_ascii_letter_counts(counts2);
+    return histograms_equal(counts1, counts2);
+}
 
-    for (char c : s1) {
-        if (is_ascii_letter(c)) {
-            char_counts[to_lower_ascii(c) - 'a']++;
+void reverse_utf8(std::string& s) {
+    // Each multi-byte character is turned around in place first, so that
+    // reversing every byte afterwards restores its byte order while it
+    // reverses the character order. ASCII bytes need neither step, and the
+    // block mask jumps straight to the next non-ASCII byte.
+    char* data = s.data();
+    const size_t n = s.length();
+    for (size_t i = 0; i < n;) {
+        if (n - i >= kAsciiBlockBytes) {
+            uint32_t mask = non_ascii_mask(data + i);
+            if (mask == 0) {
+                i += kAsciiBlockBytes;
+                continue;
+            }
+            i += static_cast<size_t>(std::countr_zero(mask));
+        } else if (static_cast<unsigned char>(data[i]) < 0x80) {
+            ++i;
+            continue;
         }
+        size_t length;
+        decode_utf8(data + i, n - i, length);
+        std::reverse(data + i, data + i + length);
+        i += length;
     }
+    reverse_bytes(data, n);
+}
 
-    for (char c : s2) {
-        if (is_ascii_letter(c)) {
-            char_counts[to_lower_ascii(c) - 'a']--;
+bool is_palindrome_utf8(const std::string& s, bool ignore_case) {
+    const char* data = s.data();
+    size_t low = 0, high = s.length();
+    while (low < high) {
+        // Where both ends start with an ASCII block, compare as many ASCII
+        // bytes as both ends allow with the block kernel.
+        if (high - low >= 2 * kAsciiBlockBytes && is_ascii_block(data + low) &&
+            is_ascii_block(data + high - kAsciiBlockBytes)) {
+            size_t half = (high - low) / 2;
+            size_t ascii = std::min(ascii_prefix_length(data + low, half),
+                                    ascii_suffix_length(data + high - half, half));
+            if (!mirrored_bytes_equal(data + low, data + high - ascii, ascii, ignore_case)) return false;
+            low += ascii;
+            high -= ascii;
+            continue;
+        }
+        // Otherwise compare character by character, for about a block.
+        for (size_t stop = low + kAsciiBlockBytes; low < high && low < stop;) {
+            char a = data[low], b = data[high - 1];
+            if (static_cast<unsigned char>(a | b) < 0x80) {
+                if (ignore_case ? fold_ascii_case(a) != fold_ascii_case(b) : a != b) return false;
+                ++low;
+                --high;
+                continue;
+            }
+            size_t front_length, back_length;
+            char32_t front = decode_utf8(data + low, high - low, front_length);
+            char32_t back = decode_utf8_back(data + low, high - low, back_length);
+            // The middle character meets itself.
+            if (low + front_length > high - back_length) return true;
+            if (ignore_case) {
+                front = fold_case_simple(front);
+                back = fold_case_simple(back);
+            }
+            if (front != back) return false;
+            low += front_length;
+            high -= back_length;
         }
     }
+    return true;
+}
+
+namespace {
+
+// Case-folded character counts of s: ASCII in a byte histogram, fed whole
+// ASCII runs at a time, two-byte characters (U+0080-U+07FF: Latin, Greek,
+// Cyrillic, Armenian, Hebrew, Arabic) in a flat table, and the rest as a
+// sorted list.
+struct Utf8Counts {
+    ByteHistogram ascii{};
+    std::vector<uint64_t> two_byte = std::vector<uint64_t>(0x800);
+    std::vector<char32_t> other;
+    bool operator==(const Utf8Counts& rhs) const {
+        return histograms_equal(ascii, rhs.ascii) && two_byte == rhs.two_byte && other == rhs.other;
+    }
+};
 
-    for (int i = 0; i < 26; ++i) {
-        if (char_counts[i] != 0) {
-            return false;
+Utf8Counts folded_utf8_counts(const std::string& s, bool skip_malformed) {
+    Utf8Counts counts;
+    const char* data = s.data();
+    const size_t n = s.length();
+    for (size_t i = 0; i < n;) {
+        size_t run = ascii_prefix_length(data + i, n - i);
+        add_byte_histogram(data + i, run, counts.ascii);
+        i += run;
+        if (i == n) break;
+        size_t length;
+        char32_t c = fold_case_simple(decode_utf8(data + i, n - i, length));
+        i += length;
+        if (c < 0x80) {
+            ++counts.ascii[c]; // e.g. U+212A KELVIN SIGN, folded to 'k'
+        } else if (c < 0x800) {
+            ++counts.two_byte[c];
+        } else if (!(skip_malformed && c >= kUtf8EscapeBase + 0x80 && c <= kUtf8EscapeBase + 0xFF)) {
+            counts.other.push_back(c);
         }
     }
+    fold_ascii_case_counts(counts.ascii);
+    std::sort(counts.other.begin(), counts.other.end());
+    return counts;
+}
 
-    return true;
+} // namespace
+
+std::vector<CodePointCount> find_duplicates_utf8(const std::string& s) {
+    Utf8Counts counts = folded_utf8_counts(s, true);
+    std::vector<CodePointCount> duplicates;
+    for (char32_t c = 'a'; c <= 'z'; ++c) {
+        if (counts.ascii[c] > 1) duplicates.push_back({c, static_cast<size_t>(counts.ascii[c])});
+    }
+    for (char32_t c = 0x80; c < 0x800; ++c) {
+        if (counts.two_byte[c] > 1) duplicates.push_back({c, static_cast<size_t>(counts.two_byte[c])});
+    }
+    const std::vector<char32_t>& other = counts.other;
+    for (size_t i = 0, j = 0; i < other.size(); i = j) {
+        while (j < other.size() && other[j] == other[i]) ++j;
+        if (j - i > 1) duplicates.push_back({other[i], j - i});
+    }
+    return duplicates;
+}
+
+bool are_anagrams_utf8(const std::string& s1, const std::string& s2) {
+    // No length check: folding can change a character's byte length
+    // (U+212A KELVIN SIGN is three bytes, 'k' one).
+    return folded_utf8_counts(s1, false) == folded_utf8_counts(s2, false);
 }
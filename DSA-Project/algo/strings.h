@@ -12,23 +12,67 @@
 #include <cassert>
 #include <vector>
 
-// Function to reverse a string in-place
+// Function to reverse a string in-place (16/32-byte SIMD blocks where available)
 void reverse_string(std::string& s);
 
-// Function to check if a string is a palindrome
-bool is_palindrome(const std::string& s);
+// Function to check if a string is a palindrome, optionally ignoring ASCII case
+bool is_palindrome(const std::string& s, bool ignore_ascii_case = false);
 
-// Function to find duplicate characters using a hash map
-void find_duplicates_hashing(const std::string& s);
+// A letter and how many times it occurs, case-insensitively.
+struct CharCount {
+    char character;
+    size_t count;
+    bool operator==(const CharCount&) const = default;
+};
 
-// Function to find duplicate characters using bitwise operations
-void find_duplicates_bitwise(const std::string& s);
+// The duplicate and anagram functions count characters with the byte
+// histogram kernel in string_kernels.h and fold ASCII case on the counts.
 
-// Function to check if two strings are anagrams
+// Function to find duplicate characters using a hash map: the letters that
+// occur more than once, lower-cased, in alphabetical order with their counts
+std::vector<CharCount> find_duplicates_hashing(const std::string& s);
+
+// Function to find duplicate characters using bitwise operations: one bit per
+// letter marks those counted more than once; same result as the hashing method
+std::vector<CharCount> find_duplicates_bitwise(const std::string& s);
+
+// Function to check if two strings are anagrams (every character, ASCII case ignored)
 bool are_anagrams_hash(const std::string& s1, const std::string& s2);
 
+// Anagram check over letters only (the strings must still be the same length)
 bool are_anagrams_bitwise(const std::string& s1, const std::string& s2);
 
+// UTF-8 versions of the functions above. They work on code points instead
+// of bytes and fold case with Unicode simple case folding, for every
+// character (see utf8.h). A malformed byte counts as one character of its own.
+// Pure-ASCII stretches are found 32 bytes at a time and go through the byte
+// kernels, so ASCII text costs about what the byte functions cost.
+
+// Reverses the order of the characters, keeping each one's bytes in order
+void reverse_utf8(std::string& s);
+
+// Palindrome check by character, optionally ignoring case
+bool is_palindrome_utf8(const std::string& s, bool ignore_case = false);
+
+// A case-folded character and how many times it occurs.
+struct CodePointCount {
+    char32_t code_point;
+    size_t count;
+    bool operator==(const CodePointCount&) const = default;
+};
+
+// Characters that occur more than once after case folding, in code point
+// order. As with find_duplicates_hashing, ASCII characters other than
+// letters are not reported; every non-ASCII character is, since telling
+// letters from symbols there would need the Unicode category tables.
+// Malformed bytes are skipped.
+std::vector<CodePointCount> find_duplicates_utf8(const std::string& s);
+
+// Whether the two strings have the same characters after case folding
+bool are_anagrams_utf8(const std::string& s1, const std::string& s2);
+
+// Both generators return all n! permutations at once; PermutationGenerator in
+// permutations.h visits them one at a time in O(n) memory.
 std::vector<std::string> generate_permutations(const std::string& s);
 
 std::vector<std::string> generate_permutations_backtracking(const std::string& s);
@@ -0,0 +1,222 @@
+//
+//  utf8.h
+//  DSA-Project
+//
+//  Created by richie on 10/19/26.
+//
+
+#ifndef UTF8_H
+#define UTF8_H
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "case_fold_table.h"
+
+// UTF-8 decoding and simple case folding for the code-point functions in
+// strings.h.
+//
+// A string splits into characters from the front: an ASCII byte, or a
+// well-formed multi-byte sequence (no overlong forms, surrogates or values
+// past U+10FFFF). Any other byte is malformed and is a character on its
+// own, decoded as U+DC80-U+DCFF ("surrogate escape"), which no well-formed
+// sequence produces. decode_utf8_back finds the same characters from the
+// back.
+//
+// non_ascii_mask and is_ascii_block test 32 bytes at once, and
+// ascii_prefix_length and ascii_suffix_length measure pure-ASCII stretches 32
+// (AVX2) or 16 (SSE2) bytes at a time, so callers can hand whole stretches to
+// the byte kernels in string_kernels.h.
+
+// Decoded value of malformed byte b.
+inline constexpr char32_t kUtf8EscapeBase = 0xDC00;
+
+inline bool is_utf8_continuation(unsigned char b) { return (b & 0xC0) == 0x80; }
+
+// Length of the sequence lead byte b starts, or 0 if b cannot start one.
+inline size_t utf8_sequence_length(unsigned char b) {
+  if (b < 0x80)
+    return 1;
+  if (b >= 0xC2 && b <= 0xDF)
+    return 2;
+  if (b >= 0xE0 && b <= 0xEF)
+    return 3;
+  if (b >= 0xF0 && b <= 0xF4)
+    return 4;
+  return 0;
+}
+
+// Decodes the character at data[0, n), n > 0, and stores its length in
+// `length`.
+inline char32_t decode_utf8(const char *data, size_t n, size_t &length) {
+  const auto *p = reinterpret_cast<const unsigned char *>(data);
+  length = 1;
+  const size_t need = utf8_sequence_length(p[0]);
+  if (need == 1)
+    return p[0];
+  const char32_t escaped = kUtf8EscapeBase + p[0];
+  if (need == 0 || need > n)
+    return escaped;
+  for (size_t i = 1; i < need; ++i)
+    if (!is_utf8_continuation(p[i]))
+      return escaped;
+  char32_t c;
+  if (need == 2) {
+    c = (char32_t(p[0] & 0x1F) << 6) | (p[1] & 0x3F);
+  } else if (need == 3) {
+    c = (char32_t(p[0] & 0x0F) << 12) | (char32_t(p[1] & 0x3F) << 6) |
+        (p[2] & 0x3F);
+    if (c < 0x800 || (c >= 0xD800 && c <= 0xDFFF))
+      return escaped;
+  } else {
+    c = (char32_t(p[0] & 0x07) << 18) | (char32_t(p[1] & 0x3F) << 12) |
+        (char32_t(p[2] & 0x3F) << 6) | (p[3] & 0x3F);
+    if (c < 0x10000 || c > 0x10FFFF)
+      return escaped;
+  }
+  length = need;
+  return c;
+}
+
+// Decodes the character that ends at data[n), n > 0, and stores its length
+// in `length`. The last character is the sequence whose lead is at most
+// three bytes back, if that lead decodes to exactly the bytes up to n;
+// otherwise the last byte is malformed on its own, as decode_utf8 would
+// have found it.
+inline char32_t decode_utf8_back(const char *data, size_t n, size_t &length) {
+  const auto *p = reinterpret_cast<const unsigned char *>(data);
+  size_t lead = n - 1;
+  while (lead > 0 && n - lead < 4 && is_utf8_continuation(p[lead]))
+    --lead;
+  if (lead < n - 1) {
+    char32_t c = decode_utf8(data + lead, n - lead, length);
+    if (length == n - lead)
+      return c;
+  }
+  length = 1;
+  return p[n - 1] < 0x80 ? char32_t(p[n - 1]) : kUtf8EscapeBase + p[n - 1];
+}
+
+inline constexpr size_t kAsciiBlockBytes = 32;
+
+// Bit i set where data[i] is not ASCII, for i < kAsciiBlockBytes.
+inline uint32_t non_ascii_mask(const char *data) {
+#if defined(__AVX2__)
+  __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data));
+  return static_cast<uint32_t>(_mm256_movemask_epi8(v));
+#elif defined(__SSE2__)
+  auto low = static_cast<uint32_t>(_mm_movemask_epi8(
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(data))));
+  auto high = static_cast<uint32_t>(_mm_movemask_epi8(
+      _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + 16))));
+  return low | (high << 16);
+#else
+  uint32_t mask = 0;
+  for (size_t i = 0; i < kAsciiBlockBytes; ++i)
+    mask |= uint32_t(static_cast<unsigned char>(data[i]) >> 7) << i;
+  return mask;
+#endif
+}
+
+// Whether data[0, kAsciiBlockBytes) is all ASCII.
+inline bool is_ascii_block(const char *data) {
+  return non_ascii_mask(data) == 0;
+}
+
+// Number of leading ASCII bytes of data[0, n).
+inline size_t ascii_prefix_length(const char *data, size_t n) {
+  size_t i = 0;
+#if defined(__AVX2__)
+  for (; i + 32 <= n; i += 32) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + i));
+    if (auto high = static_cast<uint32_t>(_mm256_movemask_epi8(v)))
+      return i + std::countr_zero(high);
+  }
+#endif
+#if defined(__SSE2__)
+  for (; i + 16 <= n; i += 16) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+    if (auto high = static_cast<uint32_t>(_mm_movemask_epi8(v)))
+      return i + std::countr_zero(high);
+  }
+#endif
+  for (; i < n && static_cast<unsigned char>(data[i]) < 0x80; ++i) {
+  }
+  return i;
+}
+
+// Number of trailing ASCII bytes of data[0, n).
+inline size_t ascii_suffix_length(const char *data, size_t n) {
+  size_t end = n;
+#if defined(__AVX2__)
+  for (; end >= 32; end -= 32) {
+    __m256i v =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + end - 32));
+    if (auto high = static_cast<uint32_t>(_mm256_movemask_epi8(v)))
+      return n - end + std::countl_zero(high);
+  }
+#endif
+#if defined(__SSE2__)
+  for (; end >= 16; end -= 16) {
+    __m128i v =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + end - 16));
+    if (auto high = static_cast<uint32_t>(_mm_movemask_epi8(v)))
+      return n - end + (std::countl_zero(high) - 16);
+  }
+#endif
+  for (; end > 0 && static_cast<unsigned char>(data[end - 1]) < 0x80; --end) {
+  }
+  return n - end;
+}
+
+inline bool is_ascii(const char *data, size_t n) {
+  return ascii_prefix_length(data, n) == n;
+}
+
+// Characters below this fold through a direct table; two-byte UTF-8 ends
+// here, so it covers Latin, Greek, Cyrillic, Armenian, Hebrew and Arabic.
+inline constexpr char32_t kCaseFoldDirect = 0x800;
+
+// Folds of every character below kCaseFoldDirect. They all fit in 16 bits.
+constexpr std::array<uint16_t, kCaseFoldDirect> make_case_fold_direct() {
+  std::array<uint16_t, kCaseFoldDirect> table{};
+  for (char32_t c = 0; c < kCaseFoldDirect; ++c)
+    table[c] = static_cast<uint16_t>(c);
+  for (const CaseFoldRun &run : kCaseFoldRuns)
+    for (char32_t c = run.first; c <= run.last && c < kCaseFoldDirect;
+         c += run.stride)
+      table[c] = static_cast<uint16_t>(c + run.delta);
+  return table;
+}
+
+inline constexpr std::array<uint16_t, kCaseFoldDirect> kCaseFoldDirectTable =
+    make_case_fold_direct();
+
+// Simple case folding (CaseFolding.txt, statuses C and S) for every
+// character, from the run table in case_fold_table.h. Characters below
+// kCaseFoldDirect are looked up directly; the rest find the last run
+// starting at or before them by binary search.
+inline char32_t fold_case_simple(char32_t c) {
+  if (c < kCaseFoldDirect)
+    return kCaseFoldDirectTable[c];
+  const CaseFoldRun *run =
+      std::upper_bound(std::begin(kCaseFoldRuns), std::end(kCaseFoldRuns), c,
+                       [](char32_t v, const CaseFoldRun &r) {
+                         return v < r.first;
+                       }) -
+      1; // the first run starts at 'A', below c
+  if (c <= run->last && ((c - run->first) & (run->stride - 1)) == 0)
+    return static_cast<char32_t>(c + run->delta);
+  return c;
+}
+
+#endif // UTF8_H
@@ -0,0 +1,918 @@
+//
+//  array_bench.cpp
+//  DSA-Project
+//
+//  Created by richie on 10/19/26.
+//
+//  Micro-benchmarks for Array<T>. Build with optimizations, e.g.
+//    g++ -std=gnu++20 -O2 -march=native -pthread bench/array_bench.cpp -o array_bench
+//  and pass a section name (e.g. `./array_bench select`) to run just that part.
+//
+
+#include "../ds/array.h"
+#include "../ds/roaring_set.h"
+#include "../ds/sequence_check.h"
+#include "../ds/set_view.h"
+#include "../ds/sketches.h"
+#include "../ds/sum_index.h"
+#include "bench_util.h"
+
+#include <cstring>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace {
+
+Array<int> ToArray(const std::vector<int> &values) {
+  Array<int> arr(values.size());
+  for (int v : values)
+    arr.Append(v);
+  return arr;
+}
+
+void BenchSelection() {
+  const size_t n = 10'000'000;
+  const int reps = 5;
+  std::cout << "Selection on " << n << " random ints (baseline: full sort)"
+            << std::endl;
+  std::vector<int> input = RandomInts(n, 0, 1'000'000'000);
+  Array<int> arr;
+
+  double full = TimeMedianMs(
+      reps, [&] { arr = ToArray(input); },
+      [&] { std::sort(arr.begin(), arr.end()); });
+  PrintRow("std::sort (full)", full);
+
+  double intro = TimeMedianMs(
+      reps, [&] { arr = ToArray(input); },
+      [&] { DoNotOptimize(arr.NthElement(n / 2)); });
+  PrintRow("NthElement median (Introselect)", intro, full);
+
+  double fr = TimeMedianMs(
+      reps, [&] { arr = ToArray(input); },
+      [&] {
+        DoNotOptimize(arr.NthElement(n / 2, SelectAlgorithm::FloydRivest));
+      });
+  PrintRow("NthElement median (FloydRivest)", fr, full);
+
+  double p99 = TimeMedianMs(
+      reps, [&] { arr = ToArray(input); },
+      [&] { DoNotOptimize(arr.NthElement(n / 100 * 99)); });
+  PrintRow("NthElement p99 (Introselect)", p99, full);
+
+  arr = ToArray(input);
+  double topk = TimeMedianMs(reps, [&] { DoNotOptimize(arr.TopK(100)); });
+  PrintRow("TopK(100)", topk, full);
+
+  double partial = TimeMedianMs(
+      reps, [&] { arr = ToArray(input); }, [&] { arr.PartialSort(100); });
+  PrintRow("PartialSort(100)", partial, full);
+}
+
+// Builds each small array the way callers do today (repeated InsertSort) and
+// compares that with appending then sorting once.
+template <typename T> void BenchSmallSortOf(const char *type_name) {
+  const size_t arrays = 100'000;
+  const int reps = 5;
+  std::cout << "Sorting " << arrays << " small Array<" << type_name << ">"
+            << std::endl;
+  for (size_t n : {8, 16, 32, 63}) {
+    std::vector<int> raw = RandomInts(arrays * n, -1'000'000, 1'000'000);
+    std::vector<T> input(raw.begin(), raw.end());
+    std::string suffix = " n=" + std::to_string(n);
+
+    double insert = TimeMedianMs(reps, [&] {
+      for (size_t a = 0; a < arrays; ++a) {
+        Array<T> arr(n);
+        for (size_t i = 0; i < n; ++i)
+          arr.InsertSort(input[a * n + i]);
+        DoNotOptimize(arr.begin());
+      }
+    });
+    PrintRow("InsertSort per element" + suffix, insert);
+
+    double stl = TimeMedianMs(reps, [&] {
+      for (size_t a = 0; a < arrays; ++a) {
+        Array<T> arr(n);
+        for (size_t i = 0; i < n; ++i)
+          arr.Append(input[a * n + i]);
+        std::sort(arr.begin(), arr.end());
+        DoNotOptimize(arr.begin());
+      }
+    });
+    PrintRow("Append + std::sort" + suffix, stl, insert);
+
+    double network = TimeMedianMs(reps, [&] {
+      for (size_t a = 0; a < arrays; ++a) {
+        Array<T> arr(n);
+        for (size_t i = 0; i < n; ++i)
+          arr.Append(input[a * n + i]);
+        arr.Sort();
+        DoNotOptimize(arr.begin());
+      }
+    });
+    PrintRow("Append + Sort (network)" + suffix, network, insert);
+  }
+}
+
+void BenchSmallSort() {
+  std::cout << "Sorting networks are "
+            << (kSortNetworkVectorized ? "AVX2" : "scalar fallback")
+            << std::endl;
+  BenchSmallSortOf<int32_t>("int32_t");
+  BenchSmallSortOf<float>("float");
+  BenchSmallSortOf<int64_t>("int64_t");
+
+  const size_t n = 10'000'000;
+  std::vector<int> input = RandomInts(n, 0, 1'000'000'000);
+  Array<int> arr;
+  std::cout << "Full Sort() on " << n << " ints (network leaves)" << std::endl;
+  double stl = TimeMedianMs(
+      3, [&] { arr = ToArray(input); },
+      [&] { std::sort(arr.begin(), arr.end()); });
+  PrintRow("std::sort", stl);
+  double sort = TimeMedianMs(
+      3, [&] { arr = ToArray(input); }, [&] { arr.Sort(); });
+  PrintRow("Array::Sort", sort, stl);
+}
+
+// Sorted, duplicate-free sample of `n` values from [0, universe).
+std::vector<int> SortedSet(size_t n, int universe, uint32_t seed) {
+  std::vector<int> values = RandomInts(n, 0, universe - 1, seed);
+  std::sort(values.begin(), values.end());
+  values.erase(std::unique(values.begin(), values.end()), values.end());
+  return values;
+}
+
+void BenchSkewedSetOps() {
+  const size_t large_n = 10'000'000;
+  const int universe = 1 << 30;
+  const int reps = 5;
+  std::cout << "Intersection/Difference, " << large_n
+            << "-element set vs smaller sets" << std::endl;
+  Array<int> large = ToArray(SortedSet(large_n, universe, 1));
+  for (size_t ratio : {1, 10, 32, 100, 1'000, 10'000, 100'000}) {
+    Array<int> small = ToArray(SortedSet(large_n / ratio, universe, 2));
+    std::string suffix = " 1:" + std::to_string(ratio);
+
+    double lin = TimeMedianMs(reps, [&] {
+      DoNotOptimize(small.Intersection(large, SetStrategy::Linear));
+    });
+    PrintRow("Intersection linear" + suffix, lin);
+    double gal = TimeMedianMs(reps, [&] {
+      DoNotOptimize(small.Intersection(large, SetStrategy::Galloping));
+    });
+    PrintRow("Intersection galloping" + suffix, gal, lin);
+    double autod = TimeMedianMs(
+        reps, [&] { DoNotOptimize(small.Intersection(large)); });
+    PrintRow("Intersection auto" + suffix, autod, lin);
+
+    double dlin = TimeMedianMs(reps, [&] {
+      DoNotOptimize(large.Difference(small, SetStrategy::Linear));
+    });
+    PrintRow("Difference large-small linear" + suffix, dlin);
+    double dgal = TimeMedianMs(reps, [&] {
+      DoNotOptimize(large.Difference(small, SetStrategy::Galloping));
+    });
+    PrintRow("Difference large-small galloping" + suffix, dgal, dlin);
+
+    double slin = TimeMedianMs(reps, [&] {
+      DoNotOptimize(small.Difference(large, SetStrategy::Linear));
+    });
+    PrintRow("Difference small-large linear" + suffix, slin);
+    double sgal = TimeMedianMs(reps, [&] {
+      DoNotOptimize(small.Difference(large, SetStrategy::Galloping));
+    });
+    PrintRow("Difference small-large galloping" + suffix, sgal, slin);
+  }
+}
+
+// Sorted unique values made of runs of consecutive integers separated by
+// random gaps, like posting lists of related IDs.
+std::vector<int> ClusteredSet(size_t n, uint32_t seed) {
+  std::mt19937 rng(seed);
+  std::vector<int> values;
+  values.reserve(n);
+  int next = 0;
+  while (values.size() < n) {
+    next += static_cast<int>(rng() % 64) + 1;
+    size_t run = rng() % 64 + 1;
+    for (size_t r = 0; r < run && values.size() < n; ++r)
+      values.push_back(next++);
+  }
+  return values;
+}
+
+void BenchVectorSetOps() {
+  const size_t n = 4'000'000;
+  const int reps = 7;
+  std::cout << "Set operations on two " << n << "-element int sets ("
+            << (has_simd_set_ops<int> ? "AVX2 kernels" : "scalar kernels")
+            << ")" << std::endl;
+  struct Input {
+    const char *name;
+    std::vector<int> a, b;
+  };
+  Input inputs[] = {
+      {"random", SortedSet(n, 8 * static_cast<int>(n), 1),
+       SortedSet(n, 8 * static_cast<int>(n), 2)},
+      {"clustered", ClusteredSet(n, 1), ClusteredSet(n, 2)},
+  };
+  for (const Input &in : inputs) {
+    Array<int> a = ToArray(in.a), b = ToArray(in.b);
+    std::string suffix = std::string(" (") + in.name + ")";
+    std::vector<int> out(in.a.size() + in.b.size() + kSimdSetOutputSlack);
+
+    double lin = TimeMedianMs(reps, [&] {
+      DoNotOptimize(a.Intersection(b, SetStrategy::Linear));
+    });
+    PrintRow("Intersection linear" + suffix, lin);
+    double branchless = TimeMedianMs(reps, [&] {
+      DoNotOptimize(intersect_branchless(a.begin(), a.GetLength(), b.begin(),
+                                         b.GetLength(), out.data()));
+    });
+    PrintRow("Intersection branchless kernel" + suffix, branchless, lin);
+    double vec = TimeMedianMs(reps, [&] {
+      DoNotOptimize(a.Intersection(b, SetStrategy::Vectorized));
+    });
+    PrintRow("Intersection vectorized" + suffix, vec, lin);
+    double autod =
+        TimeMedianMs(reps, [&] { DoNotOptimize(a.Intersection(b)); });
+    PrintRow("Intersection auto" + suffix, autod, lin);
+
+    double dlin = TimeMedianMs(reps, [&] {
+      DoNotOptimize(a.Difference(b, SetStrategy::Linear));
+    });
+    PrintRow("Difference linear" + suffix, dlin);
+    double dvec = TimeMedianMs(reps, [&] {
+      DoNotOptimize(a.Difference(b, SetStrategy::Vectorized));
+    });
+    PrintRow("Difference vectorized" + suffix, dvec, dlin);
+
+    double ulin = TimeMedianMs(
+        reps, [&] { DoNotOptimize(a.Union(b, SetStrategy::Linear)); });
+    PrintRow("Union linear" + suffix, ulin);
+    double uvec = TimeMedianMs(
+        reps, [&] { DoNotOptimize(a.Union(b, SetStrategy::Vectorized)); });
+    PrintRow("Union branchless" + suffix, uvec, ulin);
+    double uauto = TimeMedianMs(reps, [&] { DoNotOptimize(a.Union(b)); });
+    PrintRow("Union auto" + suffix, uauto, ulin);
+  }
+}
+
+// Many small intersections, as in query evaluation: a fresh Array per call
+// versus one reused output buffer.
+void BenchSetOpsInto() {
+  const size_t pairs = 2000, n = 512;
+  const int reps = 7;
+  std::cout << pairs << " intersections of " << n << "-element int sets"
+            << std::endl;
+  std::vector<Array<int>> lhs, rhs;
+  for (size_t p = 0; p < pairs; ++p) {
+    lhs.push_back(ToArray(SortedSet(n, 4 * static_cast<int>(n), 2 * p + 1)));
+    rhs.push_back(ToArray(SortedSet(n, 4 * static_cast<int>(n), 2 * p + 2)));
+  }
+
+  double alloc = TimeMedianMs(reps, [&] {
+    for (size_t p = 0; p < pairs; ++p)
+      DoNotOptimize(lhs[p].Intersection(rhs[p]));
+  });
+  PrintRow("Intersection returning Array", alloc);
+  Array<int> reused;
+  double into = TimeMedianMs(reps, [&] {
+    for (size_t p = 0; p < pairs; ++p)
+      DoNotOptimize(lhs[p].Intersection(rhs[p], reused));
+  });
+  PrintRow("Intersection into reused Array", into, alloc);
+  std::vector<int> buffer(n + kSimdSetOutputSlack);
+  double span = TimeMedianMs(reps, [&] {
+    for (size_t p = 0; p < pairs; ++p)
+      DoNotOptimize(lhs[p].Intersection(rhs[p], std::span<int>(buffer)));
+  });
+  PrintRow("Intersection into span", span, alloc);
+
+  double merge = TimeMedianMs(reps, [&] {
+    for (size_t p = 0; p < pairs; ++p)
+      DoNotOptimize(lhs[p].Merge(rhs[p]));
+  });
+  PrintRow("Merge returning Array", merge);
+  double merge_with = TimeMedianMs(
+      reps, [&] { reused = lhs[0]; },
+      [&] {
+        for (size_t p = 0; p < 8; ++p)
+          reused.MergeWith(rhs[p]);
+        DoNotOptimize(reused.GetLength());
+      });
+  double merge_chain = TimeMedianMs(
+      reps, [&] { reused = lhs[0]; },
+      [&] {
+        for (size_t p = 0; p < 8; ++p)
+          reused = reused.Merge(rhs[p]);
+        DoNotOptimize(reused.GetLength());
+      });
+  PrintRow("8 chained Merge", merge_chain);
+  PrintRow("8 chained MergeWith", merge_with, merge_chain);
+}
+
+// Combining many posting lists: chained pairwise operations against the
+// single-pass k-way versions.
+void BenchKWaySetOps() {
+  const size_t lists = 64, n = 100'000;
+  const int reps = 5;
+  std::cout << lists << " sorted lists of up to " << n << " ints"
+            << std::endl;
+  std::vector<Array<int>> sparse, dense;
+  for (size_t i = 0; i < lists; ++i) {
+    sparse.push_back(
+        ToArray(SortedSet(n, 1 << 26, static_cast<uint32_t>(i + 1))));
+    // Dense lists of varied length so the intersection is not empty.
+    size_t len = n / 4 + n * i / lists;
+    dense.push_back(ToArray(SortedSet(len, static_cast<int>(n),
+                                      static_cast<uint32_t>(100 + i))));
+  }
+
+  double merge_chain = TimeMedianMs(reps, [&] {
+    Array<int> acc = sparse[0];
+    for (size_t i = 1; i < lists; ++i)
+      acc = acc.Merge(sparse[i]);
+    DoNotOptimize(acc);
+  });
+  PrintRow("Merge chained", merge_chain);
+  double merge_all =
+      TimeMedianMs(reps, [&] { DoNotOptimize(Array<int>::MergeAll(sparse)); });
+  PrintRow("MergeAll (loser tree)", merge_all, merge_chain);
+
+  double union_chain = TimeMedianMs(reps, [&] {
+    Array<int> acc = sparse[0];
+    for (size_t i = 1; i < lists; ++i)
+      acc = acc.Union(sparse[i]);
+    DoNotOptimize(acc);
+  });
+  PrintRow("Union chained", union_chain);
+  double union_all =
+      TimeMedianMs(reps, [&] { DoNotOptimize(Array<int>::UnionAll(sparse)); });
+  PrintRow("UnionAll (loser tree)", union_all, union_chain);
+
+  double inter_chain = TimeMedianMs(reps, [&] {
+    Array<int> acc = dense[lists - 1];
+    for (size_t i = lists - 1; i-- > 0;)
+      acc = acc.Intersection(dense[i]);
+    DoNotOptimize(acc);
+  });
+  PrintRow("Intersection chained (largest first)", inter_chain);
+  double inter_all = TimeMedianMs(
+      reps, [&] { DoNotOptimize(Array<int>::IntersectAll(dense)); });
+  PrintRow("IntersectAll (smallest first)", inter_all, inter_chain);
+}
+
+// Merge-path parallel set operations against the single-threaded versions.
+void BenchParallelSetOps() {
+  const size_t n = 100'000'000;
+  const int reps = 5;
+  const size_t threads = resolve_thread_count(0);
+  std::cout << "Set operations on two " << n << "-element int sets, "
+            << threads << " threads" << std::endl;
+  Array<int> a = ToArray(SortedSet(n, 8 * static_cast<int>(n), 1));
+  Array<int> b = ToArray(SortedSet(n, 8 * static_cast<int>(n), 2));
+
+  double merge = TimeMedianMs(reps, [&] { DoNotOptimize(a.Merge(b)); });
+  PrintRow("Merge", merge);
+  double pmerge =
+      TimeMedianMs(reps, [&] { DoNotOptimize(a.ParallelMerge(b)); });
+  PrintRow("ParallelMerge", pmerge, merge);
+
+  double uni = TimeMedianMs(reps, [&] { DoNotOptimize(a.Union(b)); });
+  PrintRow("Union", uni);
+  double puni = TimeMedianMs(reps, [&] { DoNotOptimize(a.ParallelUnion(b)); });
+  PrintRow("ParallelUnion", puni, uni);
+
+  double inter =
+      TimeMedianMs(reps, [&] { DoNotOptimize(a.Intersection(b)); });
+  PrintRow("Intersection", inter);
+  double pinter =
+      TimeMedianMs(reps, [&] { DoNotOptimize(a.ParallelIntersection(b)); });
+  PrintRow("ParallelIntersection", pinter, inter);
+
+  double diff = TimeMedianMs(reps, [&] { DoNotOptimize(a.Difference(b)); });
+  PrintRow("Difference", diff);
+  double pdiff =
+      TimeMedianMs(reps, [&] { DoNotOptimize(a.ParallelDifference(b)); });
+  PrintRow("ParallelDifference", pdiff, diff);
+}
+
+// Dense ID sets as plain Arrays vs RoaringSet: memory and set operations.
+void BenchRoaringSet() {
+  const int universe = 20'000'000;
+  const int reps = 5;
+  std::cout << "ID sets over [0, " << universe << "): ~90% dense and runs"
+            << std::endl;
+  std::vector<int> dense_a, dense_b;
+  std::mt19937 rng(5);
+  for (int v = 0; v < universe; ++v) {
+    if (rng() % 10 != 0)
+      dense_a.push_back(v);
+    if ((v / 5000) % 4 != 0) // runs of 5000 with gaps
+      dense_b.push_back(v);
+  }
+  Array<int> a = ToArray(dense_a), b = ToArray(dense_b);
+  RoaringSet ra = RoaringSet::FromArray(a), rb = RoaringSet::FromArray(b);
+  std::cout << "  bytes: Array " << (a.GetLength() + b.GetLength()) * 4
+            << ", RoaringSet " << ra.SizeInBytes() + rb.SizeInBytes()
+            << std::endl;
+
+  double inter = TimeMedianMs(reps, [&] { DoNotOptimize(a.Intersection(b)); });
+  PrintRow("Array Intersection", inter);
+  double rinter =
+      TimeMedianMs(reps, [&] { DoNotOptimize(ra.Intersection(rb)); });
+  PrintRow("RoaringSet Intersection", rinter, inter);
+  double uni = TimeMedianMs(reps, [&] { DoNotOptimize(a.Union(b)); });
+  PrintRow("Array Union", uni);
+  double runi = TimeMedianMs(reps, [&] { DoNotOptimize(ra.Union(rb)); });
+  PrintRow("RoaringSet Union", runi, uni);
+
+  std::vector<int> probes = RandomInts(1'000'000, 0, universe - 1);
+  double search = TimeMedianMs(reps, [&] {
+    size_t hits = 0;
+    for (int p : probes)
+      hits += std::binary_search(a.begin(), a.end(), p);
+    DoNotOptimize(hits);
+  });
+  PrintRow("Array binary search x1M", search);
+  double contains = TimeMedianMs(reps, [&] {
+    size_t hits = 0;
+    for (int p : probes)
+      hits += ra.Contains(static_cast<uint32_t>(p));
+    DoNotOptimize(hits);
+  });
+  PrintRow("RoaringSet Contains x1M", contains, search);
+}
+
+// (a | b) & c - d: chained Array calls vs one fused pass over a lazy view.
+void BenchSetExpression() {
+  const size_t n = 4'000'000;
+  const int universe = 16 * static_cast<int>(n);
+  const int reps = 5;
+  std::cout << "(a | b) & c - d on " << n << "-element int sets" << std::endl;
+  Array<int> a = ToArray(SortedSet(n, universe, 1));
+  Array<int> b = ToArray(SortedSet(n, universe, 2));
+  Array<int> c = ToArray(SortedSet(n / 8, universe, 3)); // selective
+  Array<int> d = ToArray(SortedSet(n, universe, 4));
+
+  double chained = TimeMedianMs(reps, [&] {
+    DoNotOptimize(a.Union(b).Intersection(c).Difference(d));
+  });
+  PrintRow("Chained Array calls", chained);
+  auto expr = SetDiff(SetIntersect(SetUnion(a, b), c), d);
+  double fused = TimeMedianMs(reps, [&] { DoNotOptimize(expr.ToArray()); });
+  PrintRow("Lazy view, ToArray", fused, chained);
+  double count = TimeMedianMs(reps, [&] { DoNotOptimize(expr.Count()); });
+  PrintRow("Lazy view, Count", count, chained);
+}
+
+// Missing/duplicate finders: printing every value, as the old void versions
+// did, vs handing ranges and runs to a span or a counting sink.
+void BenchFinders() {
+  const size_t n = 10'000'000;
+  const int reps = 5;
+  std::cout << n << " random ints over [0, " << 2 * n << ")" << std::endl;
+  Array<int> values = ToArray(RandomInts(n, 0, 2 * static_cast<int>(n) - 1));
+  Array<int> sorted = values;
+  sorted.Sort();
+
+  double printed = TimeMedianMs(reps, [&] {
+    std::ostringstream out;
+    for (const MissingRange<int> &r : values.FindMultipleMissingElementsHash())
+      for (int v = r.lo; v < r.hi; ++v)
+        out << v << " ";
+    DoNotOptimize(out.tellp());
+  });
+  PrintRow("Hash missing, printed per value", printed);
+  std::vector<MissingRange<int>> ranges(n + 1);
+  double spanned = TimeMedianMs(reps, [&] {
+    DoNotOptimize(values.FindMultipleMissingElementsHash(std::span(ranges)));
+  });
+  PrintRow("Hash missing, ranges into a span", spanned, printed);
+  double counted = TimeMedianMs(reps, [&] {
+    size_t missing = 0;
+    values.FindMultipleMissingElementsHash(
+        [&](const MissingRange<int> &r) { missing += r.hi - r.lo; });
+    DoNotOptimize(missing);
+  });
+  PrintRow("Hash missing, counting sink", counted, printed);
+
+  double dup_printed = TimeMedianMs(reps, [&] {
+    std::ostringstream out;
+    for (const DuplicateRun<int> &run : sorted.FindDuplicatesSorted())
+      out << "Duplicate value: " << run.value << "\nOccurrences: " << run.count
+          << " times." << std::endl;
+    DoNotOptimize(out.tellp());
+  });
+  PrintRow("Sorted duplicates, printed", dup_printed);
+  std::vector<DuplicateRun<int>> runs(n / 2);
+  double dup_spanned = TimeMedianMs(reps, [&] {
+    DoNotOptimize(sorted.FindDuplicatesSorted(std::span(runs)));
+  });
+  PrintRow("Sorted duplicates, runs into a span", dup_spanned, dup_printed);
+}
+
+// FindMultipleMissingElementsHash before the word-level bitmap: one
+// std::vector<bool> over the whole range, tested one bit at a time.
+size_t CountMissingVectorBool(const Array<int> &values) {
+  auto [min_val, max_val] = *values.FindMinMax();
+  size_t range = static_cast<size_t>(static_cast<int64_t>(max_val) - min_val) + 1;
+  std::vector<bool> present(range, false);
+  for (int v : values)
+    present[static_cast<size_t>(static_cast<int64_t>(v) - min_val)] = true;
+  size_t missing = 0;
+  for (size_t i = 0; i < range; ++i)
+    missing += !present[i];
+  return missing;
+}
+
+void BenchMissingBitmapOver(const Array<int> &values, const char *what) {
+  const int reps = 3;
+  std::cout << values.GetLength() << " random ints over " << what
+            << std::endl;
+  double bools = TimeMedianMs(reps, [&] {
+    DoNotOptimize(CountMissingVectorBool(values));
+  });
+  PrintRow("std::vector<bool>, bit by bit", bools);
+  auto count_missing = [&](size_t threads) {
+    uint64_t missing = 0;
+    values.FindMultipleMissingElementsHash(
+        [&](const MissingRange<int> &r) {
+          missing += static_cast<uint64_t>(int64_t(r.hi) - r.lo);
+        },
+        threads);
+    return missing;
+  };
+  double words = TimeMedianMs(reps, [&] { DoNotOptimize(count_missing(1)); });
+  PrintRow("Word bitmap, 1 thread", words, bools);
+  double threaded =
+      TimeMedianMs(reps, [&] { DoNotOptimize(count_missing(0)); });
+  PrintRow("Word bitmap, all hardware threads", threaded, bools);
+}
+
+void BenchMissingBitmap() {
+  const size_t n = 100'000'000;
+  // Sparse: about 98% of the range is missing, in ~97M separate gaps.
+  BenchMissingBitmapOver(
+      ToArray(RandomInts(n, std::numeric_limits<int>::min(),
+                         std::numeric_limits<int>::max())),
+      "the full 2^32 range");
+  // Dense: under 1% missing, so most bitmap words are full and skipped.
+  BenchMissingBitmapOver(ToArray(RandomInts(n, 0, (1 << 24) - 1)),
+                         "[0, 2^24)");
+}
+
+// FindDuplicatesHashing and PairWithSum_Hashing as they were before the
+// flat hash table, on the node-based standard containers.
+size_t CountDuplicatesUnorderedMap(const Array<int> &values) {
+  std::unordered_map<int, size_t> freq;
+  for (int v : values)
+    ++freq[v];
+  size_t duplicated = 0;
+  for (const auto &entry : freq)
+    duplicated += entry.second > 1;
+  return duplicated;
+}
+
+bool PairWithSumUnorderedSet(const Array<int> &values, int k) {
+  std::unordered_set<int> seen;
+  for (int v : values) {
+    if (seen.count(k - v))
+      return true;
+    seen.insert(v);
+  }
+  return false;
+}
+
+void BenchFlatHash() {
+  for (size_t n : {1'000'000, 10'000'000, 100'000'000}) {
+    const int reps = n >= 100'000'000 ? 1 : 3;
+    // Half as many distinct values as elements, so most values repeat.
+    Array<int> values = ToArray(RandomInts(n, 0, static_cast<int>(n / 2)));
+    std::cout << n << " ints drawn from [0, " << n / 2 << "]" << std::endl;
+
+    double std_dups = TimeMedianMs(
+        reps, [&] { DoNotOptimize(CountDuplicatesUnorderedMap(values)); });
+    PrintRow("Duplicates, std::unordered_map", std_dups);
+    double flat_dups = TimeMedianMs(reps, [&] {
+      size_t duplicated = 0;
+      values.FindDuplicatesHashing(
+          [&](const DuplicateRun<int> &) { ++duplicated; });
+      DoNotOptimize(duplicated);
+    });
+    PrintRow("Duplicates, FindDuplicatesHashing", flat_dups, std_dups);
+
+    // A negative target is never found, so every element is probed.
+    double std_pair = TimeMedianMs(
+        reps, [&] { DoNotOptimize(PairWithSumUnorderedSet(values, -1)); });
+    PrintRow("Pair sum, std::unordered_set", std_pair);
+    double flat_pair = TimeMedianMs(
+        reps, [&] { DoNotOptimize(values.PairWithSum_Hashing(-1)); });
+    PrintRow("Pair sum, PairWithSum_Hashing", flat_pair, std_pair);
+  }
+}
+
+// One big table vs radix partitions counted in small tables. The target
+// workload is 500M values; 100M keeps the input and its partitioned copy
+// within a modest machine's memory.
+void BenchParallelDuplicates() {
+  const size_t n = 100'000'000;
+  const int reps = 3;
+  Array<int> values = ToArray(RandomInts(n, 0, static_cast<int>(n / 2)));
+  std::cout << n << " ints drawn from [0, " << n / 2 << "]" << std::endl;
+
+  double single = TimeMedianMs(reps, [&] {
+    size_t duplicated = 0;
+    values.FindDuplicatesHashing(
+        [&](const DuplicateRun<int> &) { ++duplicated; });
+    DoNotOptimize(duplicated);
+  });
+  PrintRow("FindDuplicatesHashing", single);
+  double partitioned = TimeMedianMs(
+      reps, [&] { DoNotOptimize(values.ParallelFindDuplicates(1)); });
+  PrintRow("ParallelFindDuplicates, 1 thread", partitioned, single);
+  double parallel = TimeMedianMs(
+      reps, [&] { DoNotOptimize(values.ParallelFindDuplicates(0)); });
+  PrintRow("ParallelFindDuplicates, all threads", parallel, single);
+  double frequencies = TimeMedianMs(
+      reps, [&] { DoNotOptimize(values.ParallelCountFrequencies(0)); });
+  PrintRow("ParallelCountFrequencies, all threads", frequencies, single);
+}
+
+// Exact answers from a hash table sized to the distinct values vs sketches
+// of fixed size. Errors are printed beside the timings.
+void BenchSketches() {
+  const size_t n = 10'000'000;
+  const int reps = 3;
+  // Half the values from a skewed set of 1000, where smaller values are
+  // more frequent; the other half nearly all distinct.
+  std::vector<int> raw = RandomInts(n, 0, 1'000'000'000);
+  for (size_t i = 0; i < n; i += 2)
+    raw[i] %= 1 + raw[i] / 1000 % 1000;
+  Array<int> values = ToArray(raw);
+  std::cout << n << " ints, half from 1000 skewed hot values" << std::endl;
+
+  size_t exact_distinct = 0;
+  double exact = TimeMedianMs(reps, [&] {
+    FlatHashSet<int> seen;
+    for (int v : values)
+      seen.Insert(v);
+    exact_distinct = seen.Size();
+  });
+  PrintRow("Distinct, FlatHashSet", exact);
+  HyperLogLog<int> hll;
+  double approx = TimeMedianMs(
+      reps, [&] { hll = HyperLogLog<int>::FromArray(values); });
+  PrintRow("Distinct, HyperLogLog", approx, exact);
+  std::cout << "  distinct " << exact_distinct << ", estimate "
+            << static_cast<size_t>(hll.Estimate()) << ", "
+            << hll.SizeInBytes() << " bytes" << std::endl;
+
+  std::vector<DuplicateRun<int>> frequencies;
+  double counted = TimeMedianMs(
+      reps, [&] { frequencies = values.ParallelCountFrequencies(1); });
+  PrintRow("Top 10, ParallelCountFrequencies + sort", counted);
+  std::sort(frequencies.begin(), frequencies.end(),
+            [](const auto &a, const auto &b) { return a.count > b.count; });
+  SpaceSaving<int> top(1000);
+  double summarized = TimeMedianMs(
+      reps, [&] { top = SpaceSaving<int>::FromArray(values, 1000); });
+  PrintRow("Top 10, SpaceSaving(1000)", summarized, counted);
+  size_t agree = 0;
+  for (const auto &c : top.TopK(10))
+    for (size_t i = 0; i < 10; ++i)
+      agree += frequencies[i].value == c.value;
+  std::cout << "  " << agree << " of the exact top 10 found" << std::endl;
+
+  auto sketch = CountMinSketch<int>::WithErrorBounds(0.0001, 0.001);
+  double cms = TimeMedianMs(reps, [&] {
+    sketch = CountMinSketch<int>(sketch.Width(), sketch.Depth());
+    for (int v : values)
+      sketch.Append(v);
+  });
+  PrintRow("Counts, CountMinSketch", cms, counted);
+  // The bound holds per query with probability 1 - delta.
+  const uint64_t bound = static_cast<uint64_t>(0.0001 * n);
+  size_t over = 0;
+  for (const auto &run : frequencies)
+    over += sketch.Estimate(run.value) - run.count > bound;
+  std::cout << "  " << over << " of " << frequencies.size()
+            << " estimates off by more than " << bound << ", "
+            << sketch.SizeInBytes() << " bytes" << std::endl;
+
+  BloomFilter<int> filter(64, 1);
+  double bloom = TimeMedianMs(
+      reps, [&] { filter = BloomFilter<int>::FromArray(values, 0.01); });
+  PrintRow("Membership, BloomFilter(1%)", bloom, exact);
+  std::cout << "  " << filter.SizeInBytes() << " bytes, false positives "
+            << filter.EstimatedFalsePositiveRate() << std::endl;
+}
+
+// Every applicable plan of each dispatched query at several value ranges,
+// with the plan Auto picks marked, to check the cost model's crossovers.
+void BenchQueryDispatch() {
+  const size_t n = 4'000'000;
+  const int reps = 3;
+  const QueryPlan duplicate_plans[] = {
+      QueryPlan::DirectAddress, QueryPlan::Hashing, QueryPlan::ParallelHashing};
+  const QueryPlan missing_plans[] = {QueryPlan::DirectAddress,
+                                     QueryPlan::SortedCopy};
+  const QueryPlan pair_plans[] = {QueryPlan::DirectAddress, QueryPlan::Hashing};
+
+  auto run = [&](const char *query, auto &plans, QueryPlan chosen,
+                 auto &&call) {
+    double first = 0;
+    for (QueryPlan plan : plans) {
+      double ms = 0;
+      try {
+        ms = TimeMedianMs(reps, [&] { call(plan); });
+      } catch (const std::invalid_argument &) {
+        continue; // range too wide to address directly
+      }
+      std::string label = std::string(query) + ", " + QueryPlanName(plan) +
+                          (plan == chosen ? " *" : "");
+      PrintRow(label, ms, first);
+      if (first == 0)
+        first = ms;
+    }
+  };
+  for (uint64_t factor : {1, 4, 16, 64, 256, 1024}) {
+    const int hi = static_cast<int>(std::min<uint64_t>(n * factor, INT32_MAX));
+    Array<int> values = ToArray(RandomInts(n, 0, hi - 1));
+    std::cout << n << " ints drawn from [0, " << hi << ")" << std::endl;
+    run("FindDuplicates", duplicate_plans, values.PlanFindDuplicates(),
+        [&](QueryPlan plan) {
+          size_t found = 0;
+          values.FindDuplicates([&](const DuplicateRun<int> &) { ++found; },
+                                plan);
+          DoNotOptimize(found);
+        });
+    run("FindMissing", missing_plans, values.PlanFindMissing(),
+        [&](QueryPlan plan) {
+          size_t found = 0;
+          values.FindMissing([&](const MissingRange<int> &) { ++found; },
+                             plan);
+          DoNotOptimize(found);
+        });
+    // A negative target is never found, so every element is probed.
+    run("PairWithSum", pair_plans, values.PlanPairWithSum(),
+        [&](QueryPlan plan) { DoNotOptimize(values.PairWithSum(-1, plan)); });
+  }
+}
+
+// Many targets against one array: a per-call PairWithSum_Hashing, which
+// rebuilds its set every time, vs one SumIndex answering the whole batch.
+// Rows are printed as targets per second.
+void BenchSumIndex() {
+  const size_t n = 100'000;
+  const int reps = 3;
+  std::vector<int> raw = RandomInts(n, 0, 1'000'000'000);
+  // Half the targets are the sum of two elements, half are odd sums of
+  // even values and never match.
+  std::vector<int> evens = raw;
+  for (int &v : evens)
+    v &= ~1;
+  Array<int> even_values = ToArray(evens);
+  std::vector<int> targets = RandomInts(4'000, 0, 1'000'000'000);
+  for (size_t i = 0; i < targets.size(); ++i)
+    targets[i] = i % 2 == 0 ? evens[i % n] + evens[(i * 7919) % n]
+                            : targets[i] | 1;
+  std::cout << n << " ints, " << targets.size()
+            << " targets (half with a pair)" << std::endl;
+
+  auto rate = [&](const std::string &label, size_t count, double ms,
+                  double baseline) {
+    std::cout << "  " << label << ": " << static_cast<size_t>(count / ms * 1e3)
+              << " targets/s";
+    if (baseline > 0)
+      std::cout << " (" << baseline / (ms / count) << "x)";
+    std::cout << std::endl;
+  };
+  const size_t few = 200; // the per-call baseline is slow
+  double per_call = TimeMedianMs(reps, [&] {
+    for (size_t i = 0; i < few; ++i)
+      DoNotOptimize(even_values.PairWithSum_Hashing(targets[i]));
+  });
+  rate("PairWithSum_Hashing per target", few, per_call, 0);
+  const double baseline = per_call / few;
+
+  double build = TimeMedianMs(reps, [&] { SumIndex<int> index(even_values); });
+  PrintRow("SumIndex build", build);
+  SumIndex<int> index(even_values);
+  double find = TimeMedianMs(
+      reps, [&] { DoNotOptimize(index.FindPairs(targets, 1)); });
+  rate("SumIndex::FindPairs, 1 thread", targets.size(), find, baseline);
+  double find_all = TimeMedianMs(
+      reps, [&] { DoNotOptimize(index.FindPairs(targets, 0)); });
+  rate("SumIndex::FindPairs, all threads", targets.size(), find_all,
+       baseline);
+  double count = TimeMedianMs(
+      reps, [&] { DoNotOptimize(index.CountPairs(targets, 1)); });
+  rate("SumIndex::CountPairs, 1 thread", targets.size(), count, baseline);
+
+  // Triples cost O(d^2) per target, so they run on a smaller array.
+  Array<int> small = ToArray(RandomInts(2'000, 0, 1'000'000));
+  SumIndex<int> small_index(small);
+  std::vector<int> triple_targets = RandomInts(200, 0, 3'000'000);
+  double triples = TimeMedianMs(reps, [&] {
+    DoNotOptimize(small_index.CountTriples(triple_targets, 1));
+  });
+  rate("SumIndex::CountTriples on 2000 ints, 1 thread",
+       triple_targets.size(), triples, 0);
+}
+
+// Checking a shuffled stream of sequence numbers with two gaps, fed in 64K
+// chunks: the Array finders, which need the whole stream collected first,
+// vs the streaming digest and tracker, which see each chunk once.
+void BenchSequenceStream() {
+  const uint64_t n = 50'000'000;
+  const size_t chunk = 1 << 16;
+  const int reps = 3;
+  std::vector<int> stream(n);
+  for (uint64_t i = 0; i < n; ++i)
+    stream[i] = static_cast<int>(i);
+  std::mt19937 rng(42);
+  std::shuffle(stream.begin(), stream.end(), rng);
+  stream.resize(n - 2);
+  std::cout << stream.size() << " sequence numbers of [0, " << n
+            << "), two missing, in chunks of " << chunk << std::endl;
+  auto for_each_chunk = [&](auto &&fn) {
+    for (size_t i = 0; i < stream.size(); i += chunk)
+      fn(std::span<const int>(stream).subspan(
+          i, std::min(chunk, stream.size() - i)));
+  };
+
+  double collect = TimeMedianMs(reps, [&] {
+    Array<int> all(stream.size());
+    for_each_chunk([&](std::span<const int> part) {
+      for (int v : part)
+        all.Append(v);
+    });
+    DoNotOptimize(all.FindMultipleMissingElementsHash());
+  });
+  PrintRow("collect into Array + FindMultipleMissingElementsHash", collect);
+  Array<int> collected = ToArray(stream);
+  collected.Append(static_cast<int>(n - 2)); // leave only one gap
+  double single = TimeMedianMs(reps, [&] {
+    DoNotOptimize(collected.FindSingleMissingElementUnsortedOptimal());
+  });
+  PrintRow("FindSingleMissingElementUnsortedOptimal, collected", single,
+           collect);
+  double digest = TimeMedianMs(reps, [&] {
+    SequenceDigest<int> check(0, n);
+    for_each_chunk([&](std::span<const int> part) { check.Append(part); });
+    DoNotOptimize(check.Diagnose());
+  });
+  PrintRow("SequenceDigest, O(1) memory", digest, collect);
+  double tracker = TimeMedianMs(reps, [&] {
+    SequenceTracker<int> check(0, n);
+    size_t flagged = 0;
+    for_each_chunk([&](std::span<const int> part) {
+      check.Append(part, [&](const int &, SequenceFlag) { ++flagged; });
+    });
+    DoNotOptimize(flagged);
+    DoNotOptimize(check.Missing());
+  });
+  PrintRow("SequenceTracker, n/8 bytes", tracker, collect);
+}
+
+struct Section {
+  const char *name;
+  void (*run)();
+};
+
+const Section kSections[] = {
+    {"select", BenchSelection},
+    {"smallsort", BenchSmallSort},
+    {"gallop", BenchSkewedSetOps},
+    {"simdset", BenchVectorSetOps},
+    {"into", BenchSetOpsInto},
+    {"kway", BenchKWaySetOps},
+    {"parallel", BenchParallelSetOps},
+    {"roaring", BenchRoaringSet},
+    {"setexpr", BenchSetExpression},
+    {"finders", BenchFinders},
+    {"missing", BenchMissingBitmap},
+    {"hash", BenchFlatHash},
+    {"pardup", BenchParallelDuplicates},
+    {"sketch", BenchSketches},
+    {"dispatch", BenchQueryDispatch},
+    {"ksum", BenchSumIndex},
+    {"stream", BenchSequenceStream},
+};
+
+} // namespace
+
+int main(int argc, char **argv) {
+  for (const Section &section : kSections) {
+    if (argc > 1 && std::strcmp(argv[1], section.name) != 0)
+      continue;
+    section.run();
+    std::cout << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,79 @@
+//
+//  bench_util.h
+//  DSA-Project
+//
+//  Created by richie on 10/19/26.
+//
+
+#ifndef BENCH_UTIL_H
+#define BENCH_UTIL_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+// Keeps the optimizer from discarding a result that is otherwise unused.
+template <typename T> inline void DoNotOptimize(const T &value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+// Runs `setup` then times `body` `reps` times and returns the median in
+// milliseconds. Setup time (copying inputs, etc.) is excluded.
+template <typename Setup, typename Body>
+double TimeMedianMs(int reps, Setup setup, Body body) {
+  std::vector<double> samples;
+  for (int r = 0; r < reps; ++r) {
+    setup();
+    auto start = std::chrono::steady_clock::now();
+    body();
+    auto stop = std::chrono::steady_clock::now();
+    samples.push_back(
+        std::chrono::duration<double, std::milli>(stop - start).count());
+  }
+  std::sort(samples.begin(), samples.end());
+  return samples[samples.size() / 2];
+}
+
+template <typename Body> double TimeMedianMs(int reps, Body body) {
+  return TimeMedianMs(reps, [] {}, body);
+}
+
+inline void PrintRow(const std::string &label, double ms,
+                     double baseline_ms = 0.0) {
+  std::cout << "  " << std::left << std::setw(40) << label << std::right
+            << std::setw(10) << std::fixed << std::setprecision(2) << ms
+            << " ms";
+  if (baseline_ms > 0.0)
+    std::cout << "  (" << std::setprecision(1) << baseline_ms / ms << "x)";
+  std::cout << std::endl;
+}
+
+// PrintRow for streaming kernels: bytes processed per second instead of the
+// raw time.
+inline void PrintThroughput(const std::string &label, double bytes, double ms,
+                            double baseline_ms = 0.0) {
+  std::cout << "  " << std::left << std::setw(40) << label << std::right
+            << std::setw(10) << std::fixed << std::setprecision(2)
+            << bytes / (ms * 1e6) << " GB/s";
+  if (baseline_ms > 0.0)
+    std::cout << "  (" << std::setprecision(1) << baseline_ms / ms << "x)";
+  std::cout << std::endl;
+}
+
+// Fixed seed so runs are comparable across machines and commits.
+inline std::vector<int> RandomInts(size_t n, int lo, int hi,
+                                   uint32_t seed = 42) {
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<int> dist(lo, hi);
+  std::vector<int> values(n);
+  for (auto &v : values)
+    v = dist(rng);
+  return values;
+}
+
+#endif // BENCH_UTIL_H
@@ -0,0 +1,430 @@
+//
+//  string_bench.cpp
+//  DSA-Project
+//
+//  Created by richie on 10/19/26.
+//
+//  Micro-benchmarks for the string kernels. Build with optimizations, e.g.
+//    g++ -std=gnu++20 -O2 -march=native -pthread bench/string_bench.cpp algo/strings.cpp -o string_bench
+//  and pass a section name (e.g. `./string_bench reverse`) to run just that part.
+//
+
+#include "../algo/permutations.h"
+#include "../algo/string_kernels.h"
+#include "../algo/string_search.h"
+#include "../algo/strings.h"
+#include "../algo/utf8.h"
+#include "../ds/anagram_groups.h"
+#include "bench_util.h"
+
+#include <array>
+#include <cstring>
+#include <set>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+
+namespace {
+
+// n random bytes drawn from `alphabet`, with a fixed seed.
+std::string RandomText(size_t n, const std::string &alphabet,
+                       uint32_t seed = 42) {
+  std::mt19937 rng(seed);
+  std::uniform_int_distribution<size_t> dist(0, alphabet.size() - 1);
+  std::string text(n, ' ');
+  for (char &c : text)
+    c = alphabet[dist(rng)];
+  return text;
+}
+
+// Multi-megabyte buffers: the scalar two-pointer loops vs the block kernels.
+// The palindromes are full-length, so no row stops early.
+void BenchReversePalindrome() {
+  const int reps = 9;
+  for (size_t n : {size_t(64) << 10, size_t(16) << 20}) {
+    std::string text = RandomText(n, "abcdefghijklmnopqrstuvwxyz");
+    std::cout << (n >> 10) << " KiB buffer" << std::endl;
+    double scalar = TimeMedianMs(reps, [&] {
+      reverse_bytes_scalar(text.data(), text.size());
+      DoNotOptimize(text[0]);
+    });
+    PrintThroughput("reverse_bytes_scalar", n, scalar);
+    double library = TimeMedianMs(reps, [&] {
+      std::reverse(text.begin(), text.end());
+      DoNotOptimize(text[0]);
+    });
+    PrintThroughput("std::reverse", n, library, scalar);
+    double simd = TimeMedianMs(reps, [&] {
+      reverse_bytes(text.data(), text.size());
+      DoNotOptimize(text[0]);
+    });
+    PrintThroughput("reverse_bytes", n, simd, scalar);
+
+    std::string palindrome = text.substr(0, n / 2);
+    palindrome.append(palindrome.rbegin(), palindrome.rend());
+    std::string mixed = palindrome;
+    for (size_t i = 0; i < mixed.size(); i += 3)
+      mixed[i] = static_cast<char>(mixed[i] & ~0x20); // upper-case every third
+    double check_scalar = TimeMedianMs(reps, [&] {
+      DoNotOptimize(
+          is_palindrome_bytes_scalar(palindrome.data(), palindrome.size()));
+    });
+    PrintThroughput("is_palindrome_bytes_scalar", n, check_scalar);
+    double check_simd = TimeMedianMs(reps, [&] {
+      DoNotOptimize(is_palindrome_bytes(palindrome.data(), palindrome.size()));
+    });
+    PrintThroughput("is_palindrome_bytes", n, check_simd, check_scalar);
+    double fold_scalar = TimeMedianMs(reps, [&] {
+      DoNotOptimize(
+          is_palindrome_bytes_scalar(mixed.data(), mixed.size(), true));
+    });
+    PrintThroughput("is_palindrome_bytes_scalar, ASCII case", n, fold_scalar);
+    double fold_simd = TimeMedianMs(reps, [&] {
+      DoNotOptimize(is_palindrome_bytes(mixed.data(), mixed.size(), true));
+    });
+    PrintThroughput("is_palindrome_bytes, ASCII case", n, fold_simd,
+                    fold_scalar);
+  }
+}
+
+// Character counting on 16 MiB of text: the std::unordered_map<char, int>
+// loop the duplicate and anagram functions used to run, one 256-entry table,
+// and byte_histogram's four interleaved tables. The run-heavy text repeats
+// each byte many times in a row, which serializes updates to a single table.
+void BenchHistogram() {
+  const int reps = 5;
+  const size_t n = size_t(16) << 20;
+  std::string runs;
+  for (std::mt19937 rng(7); runs.size() < n;)
+    runs.append(1 + rng() % 64, static_cast<char>('a' + rng() % 26));
+  runs.resize(n);
+  const std::pair<const char *, std::string> inputs[] = {
+      {"random letters", RandomText(n, "abcdefghijklmnopqrstuvwxyz")},
+      {"runs of one letter", runs}};
+  for (const auto &[what, text] : inputs) {
+    std::cout << "16 MiB of " << what << std::endl;
+    double map = TimeMedianMs(reps, [&] {
+      std::unordered_map<char, int> freq;
+      for (char c : text)
+        freq[c]++;
+      DoNotOptimize(freq.size());
+    });
+    PrintThroughput("std::unordered_map<char, int>", n, map);
+    double single = TimeMedianMs(reps, [&] {
+      ByteHistogram counts{};
+      for (unsigned char c : text)
+        ++counts[c];
+      DoNotOptimize(counts);
+    });
+    PrintThroughput("one table", n, single, map);
+    double interleaved = TimeMedianMs(reps, [&] {
+      DoNotOptimize(byte_histogram(text.data(), text.size()));
+    });
+    PrintThroughput("byte_histogram, four tables", n, interleaved, map);
+  }
+}
+
+// All 10! permutations of 10 distinct characters: generate_permutations,
+// which returns a vector of 3.6M strings, vs PermutationGenerator, which
+// rearranges one buffer. Each permutation's first byte is read, so both
+// sides touch every result.
+void BenchPermutations() {
+  const int reps = 3;
+  const std::string s = "abcdefghij";
+  std::cout << "permutations of \"" << s << "\"" << std::endl;
+  double vector = TimeMedianMs(reps, [&] {
+    size_t sum = 0;
+    for (const std::string &p : generate_permutations(s))
+      sum += static_cast<unsigned char>(p[0]);
+    DoNotOptimize(sum);
+  });
+  PrintRow("generate_permutations", vector);
+  double lazy = TimeMedianMs(reps, [&] {
+    size_t sum = 0;
+    for (std::string_view p : PermutationGenerator(s))
+      sum += static_cast<unsigned char>(p[0]);
+    DoNotOptimize(sum);
+  });
+  PrintRow("PermutationGenerator", lazy, vector);
+  std::cout << "  memory: " << 3628800 * sizeof(std::string) / (1 << 20)
+            << " MiB of strings vs one " << s.size()
+            << "-byte buffer and " << s.size() << " counters" << std::endl;
+}
+
+// All 11! permutations of 11 characters: Heap's-order PermutationGenerator
+// and the rank-order generator on one thread, then rank blocks spread over
+// every hardware thread, each counting into its own slot.
+void BenchParallelPermutations() {
+  const int reps = 3;
+  const std::string s = "abcdefghijk";
+  std::cout << permutation_count(s.size()) << " permutations of \"" << s
+            << "\"" << std::endl;
+  double heap = TimeMedianMs(reps, [&] {
+    size_t sum = 0;
+    for_each_permutation(s, [&](std::string_view p) {
+      sum += static_cast<unsigned char>(p.back());
+    });
+    DoNotOptimize(sum);
+  });
+  PrintRow("for_each_permutation", heap);
+  double ranked = TimeMedianMs(reps, [&] {
+    size_t sum = 0;
+    for_each_permutation_in_range(s, 0, UINT64_MAX, [&](std::string_view p) {
+      sum += static_cast<unsigned char>(p.back());
+    });
+    DoNotOptimize(sum);
+  });
+  PrintRow("for_each_permutation_in_range", ranked, heap);
+  const size_t threads = resolve_thread_count(0);
+  double parallel = TimeMedianMs(reps, [&] {
+    // One padded slot per worker, so the sinks do not share cache lines.
+    std::vector<std::array<size_t, 8>> sums(threads);
+    for_each_permutation_parallel(s, 0, [&](size_t w, std::string_view p) {
+      sums[w][0] += static_cast<unsigned char>(p.back());
+    });
+    DoNotOptimize(sums);
+  });
+  PrintRow("for_each_permutation_parallel, " + std::to_string(threads) +
+               " threads",
+           parallel, heap);
+}
+
+// A string with repeated characters: generate_permutations plus a std::set
+// to drop repeats, visiting all n! arrangements lazily (repeats included),
+// and DistinctPermutationGenerator, which only produces the distinct ones.
+void BenchDistinctPermutations() {
+  const int reps = 3;
+  const std::string s = "aabbccdde";
+  std::cout << "\"" << s << "\": " << permutation_count(s.size())
+            << " permutations, " << count_distinct_permutations(s)
+            << " distinct" << std::endl;
+  double dedupe = TimeMedianMs(reps, [&] {
+    std::vector<std::string> all = generate_permutations(s);
+    std::set<std::string> distinct(all.begin(), all.end());
+    DoNotOptimize(distinct.size());
+  });
+  PrintRow("generate_permutations + std::set", dedupe);
+  double lazy = TimeMedianMs(reps, [&] {
+    size_t sum = 0;
+    for_each_permutation(s, [&](std::string_view p) {
+      sum += static_cast<unsigned char>(p.back());
+    });
+    DoNotOptimize(sum);
+  });
+  PrintRow("for_each_permutation (with repeats)", lazy, dedupe);
+  double distinct = TimeMedianMs(reps, [&] {
+    size_t sum = 0;
+    for_each_distinct_permutation(s, [&](std::string_view p) {
+      sum += static_cast<unsigned char>(p.back());
+    });
+    DoNotOptimize(sum);
+  });
+  PrintRow("for_each_distinct_permutation", distinct, dedupe);
+}
+
+// A 4M-word list (about 300k distinct words, 4-10 letters, each repeated
+// in scrambled order): the usual std::unordered_map from sorted key to a
+// vector of strings, vs AnagramGroups on one thread and on every hardware
+// thread. Both sides start from the raw text.
+void BenchAnagramGroups() {
+  const int reps = 3;
+  std::mt19937 rng(11);
+  std::vector<std::string> vocabulary(300000);
+  for (std::string &word : vocabulary)
+    word = RandomText(4 + rng() % 7, "abcdefghijklmnopqrstuvwxyz", rng());
+  std::string text;
+  for (size_t i = 0; i < (size_t(4) << 20); ++i) {
+    std::string word = vocabulary[rng() % vocabulary.size()];
+    std::shuffle(word.begin(), word.end(), rng);
+    text += word;
+    text += '\n';
+  }
+  std::cout << (text.size() >> 20) << " MiB word list" << std::endl;
+  double map = TimeMedianMs(reps, [&] {
+    std::unordered_map<std::string, std::vector<std::string>> groups;
+    std::istringstream in(text);
+    for (std::string word; in >> word;) {
+      std::string key = word;
+      for (char &c : key)
+        c = fold_ascii_case(c);
+      std::sort(key.begin(), key.end());
+      groups[key].push_back(word);
+    }
+    DoNotOptimize(groups.size());
+  });
+  PrintRow("std::unordered_map<std::string, vector>", map);
+  double one = TimeMedianMs(reps, [&] {
+    DoNotOptimize(AnagramGroups::FromText(text, 1).GroupCount());
+  });
+  PrintRow("AnagramGroups, 1 thread", one, map);
+  const size_t threads = resolve_thread_count(0);
+  double all = TimeMedianMs(reps, [&] {
+    DoNotOptimize(AnagramGroups::FromText(text, 0).GroupCount());
+  });
+  PrintRow("AnagramGroups, " + std::to_string(threads) + " threads", all, map);
+}
+
+// Every occurrence of one pattern in 16 MiB of random lowercase text with
+// spaces (the pattern is cut from the text): std::string::find and glibc's
+// memmem restarted after each match, count_substrings with its
+// length-based choice, and each StringSearcher method forced.
+void BenchSubstringSearch() {
+  const int reps = 5;
+  const size_t n = size_t(16) << 20;
+  const std::string text = RandomText(n, "abcdefghijklmnopqrstuvwxyz ");
+  const std::pair<const char *, SearchMethod> methods[] = {
+      {"filter", SearchMethod::Filter},
+      {"Horspool", SearchMethod::Horspool},
+      {"Two-Way", SearchMethod::TwoWay}};
+  for (size_t m : {4, 16, 64, 512}) {
+    const std::string pattern = text.substr(n / 2, m);
+    std::cout << m << "-byte pattern, " << count_substrings(text, pattern)
+              << " matches" << std::endl;
+    double library = TimeMedianMs(reps, [&] {
+      size_t count = 0;
+      for (size_t at = text.find(pattern); at != std::string::npos;
+           at = text.find(pattern, at + 1))
+        ++count;
+      DoNotOptimize(count);
+    });
+    PrintThroughput("std::string::find", n, library);
+    double glibc = TimeMedianMs(reps, [&] {
+      size_t count = 0;
+      for (const char *at = text.data(), *end = at + n;
+           (at = static_cast<const char *>(
+                memmem(at, end - at, pattern.data(), m)));
+           ++at)
+        ++count;
+      DoNotOptimize(count);
+    });
+    PrintThroughput("memmem", n, glibc, library);
+    double chosen = TimeMedianMs(reps, [&] {
+      DoNotOptimize(count_substrings(text, pattern));
+    });
+    PrintThroughput("count_substrings", n, chosen, library);
+    for (const auto &[name, method] : methods) {
+      StringSearcher searcher(pattern, method);
+      double forced = TimeMedianMs(reps, [&] {
+        DoNotOptimize(searcher.Count(text));
+      });
+      PrintThroughput(std::string("  ") + name, n, forced, library);
+    }
+  }
+}
+
+// Every occurrence of 200 dictionary words (4-8 letters, drawn from the
+// text) in 4 MiB of text: one std::string::find loop per word vs one
+// AhoCorasick pass.
+void BenchDictionarySearch() {
+  const int reps = 3;
+  const size_t n = size_t(4) << 20;
+  const std::string text = RandomText(n, "abcdefghijklmnopqrstuvwxyz ");
+  std::vector<std::string> words;
+  for (std::mt19937 rng(3); words.size() < 200;)
+    words.push_back(text.substr(rng() % (n - 8), 4 + rng() % 5));
+  std::cout << words.size() << " patterns" << std::endl;
+  double loop = TimeMedianMs(reps, [&] {
+    size_t count = 0;
+    for (const std::string &word : words)
+      for (size_t at = text.find(word); at != std::string::npos;
+           at = text.find(word, at + 1))
+        ++count;
+    DoNotOptimize(count);
+  });
+  PrintThroughput("std::string::find per pattern", n, loop);
+  const AhoCorasick automaton(words);
+  double single = TimeMedianMs(reps, [&] {
+    DoNotOptimize(automaton.Count(text));
+  });
+  PrintThroughput("AhoCorasick::Count", n, single, loop);
+}
+
+// 16 MiB of pure ASCII and of French-like text (about one accented letter
+// in 12): the UTF-8 functions vs a character-at-a-time reversal through
+// decode_utf8, and vs the byte functions on the same buffer.
+void BenchUtf8() {
+  const int reps = 5;
+  const size_t n = size_t(16) << 20;
+  std::string mixed;
+  for (std::mt19937 rng(5); mixed.size() + 2 <= n;) {
+    if (rng() % 12 == 0)
+      mixed += (rng() % 2) ? "\xC3\xA9" : "\xC3\xA8"; // é, è
+    else
+      mixed += static_cast<char>('a' + rng() % 26);
+  }
+  mixed.resize(n, 'a');
+  const std::pair<const char *, std::string> inputs[] = {
+      {"ASCII text", RandomText(n, "abcdefghijklmnopqrstuvwxyz ")},
+      {"French-like text", mixed}};
+  for (const auto &[what, text] : inputs) {
+    std::cout << "16 MiB of " << what << std::endl;
+    std::string buffer = text;
+    double by_char = TimeMedianMs(reps, [&] {
+      std::string out(text.size(), ' ');
+      size_t end = out.size();
+      for (size_t i = 0, length; i < text.size(); i += length) {
+        decode_utf8(text.data() + i, text.size() - i, length);
+        end -= length;
+        std::memcpy(out.data() + end, text.data() + i, length);
+      }
+      DoNotOptimize(out[0]);
+    });
+    PrintThroughput("reverse, one character at a time", n, by_char);
+    double utf8 = TimeMedianMs(reps, [&] {
+      reverse_utf8(buffer);
+      DoNotOptimize(buffer[0]);
+    });
+    PrintThroughput("reverse_utf8", n, utf8, by_char);
+    double bytes = TimeMedianMs(reps, [&] {
+      reverse_string(buffer);
+      DoNotOptimize(buffer[0]);
+    });
+    PrintThroughput("reverse_string (bytes)", n, bytes, by_char);
+
+    std::string palindrome = text.substr(0, n / 2);
+    std::string back = palindrome;
+    reverse_utf8(back);
+    palindrome += back;
+    double check = TimeMedianMs(reps, [&] {
+      DoNotOptimize(is_palindrome_utf8(palindrome, true));
+    });
+    PrintThroughput("is_palindrome_utf8, ignoring case", n, check);
+    double anagram = TimeMedianMs(reps, [&] {
+      DoNotOptimize(are_anagrams_utf8(text, text));
+    });
+    PrintThroughput("are_anagrams_utf8", 2 * n, anagram);
+    double anagram_bytes = TimeMedianMs(reps, [&] {
+      DoNotOptimize(are_anagrams_hash(text, text));
+    });
+    PrintThroughput("are_anagrams_hash (bytes)", 2 * n, anagram_bytes);
+  }
+}
+
+struct Section {
+  const char *name;
+  void (*run)();
+};
+
+const Section kSections[] = {
+    {"reverse", BenchReversePalindrome},
+    {"histogram", BenchHistogram},
+    {"permute", BenchPermutations},
+    {"parperm", BenchParallelPermutations},
+    {"multiset", BenchDistinctPermutations},
+    {"anagram", BenchAnagramGroups},
+    {"search", BenchSubstringSearch},
+    {"dictionary", BenchDictionarySearch},
+    {"utf8", BenchUtf8},
+};
+
+} // namespace
+
+int main(int argc, char **argv) {
+  for (const Section &section : kSections) {
+    if (argc > 1 && std::strcmp(argv[1], section.name) != 0)
+      continue;
+    section.run();
+    std::cout << std::endl;
+  }
+  return 0;
+}
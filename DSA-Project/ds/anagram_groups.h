@@ -0,0 +1,353 @@
+//
+//  anagram_groups.h
+//  DSA-Project
+//
+//  Created by richie on 10/19/26.
+//
+
+#ifndef ANAGRAM_GROUPS_H
+#define ANAGRAM_GROUPS_H
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "../algo/hash_partition.h"
+#include "../algo/parallel.h"
+#include "../algo/result_sink.h"
+#include "../algo/string_kernels.h"
+#include "flat_hash.h"
+
+// Groups a word list into anagram classes in one pass, where comparing
+// words pairwise with are_anagrams_hash would take quadratic time.
+//
+// Each word gets a canonical signature, its characters ASCII-case-folded
+// and sorted ("Listen" and "silent" both become "eilnst"), so two words are
+// anagrams exactly when their signatures are equal, with the same rule as
+// are_anagrams_hash. The words are then radix-partitioned by signature hash
+// (hash_partition.h) and each partition is grouped in its own
+// FlatHashMap from signature to group, one partition per thread at a time.
+//
+// The text is kept in one buffer and the words are views into it; there is
+// no allocation per word. Groups are numbered in order of their first word,
+// and each lists its words in input order, whatever the thread count.
+// Repeated words stay repeated within their group.
+
+namespace anagram_detail {
+
+// ' ', '\t', '\n', '\v', '\f' and '\r' as one mask test.
+inline bool IsSpace(char c) {
+  const uint64_t spaces = (uint64_t(1) << ' ') | (uint64_t(0x1F) << '\t');
+  auto b = static_cast<unsigned char>(c);
+  return b <= ' ' && ((spaces >> b) & 1);
+}
+
+// Writes the signature of `word` to out[0, word.size()).
+inline void Signature(std::string_view word, char *out) {
+  const size_t n = word.size();
+#if defined(__SSSE3__)
+  // Words of up to 16 bytes are sorted by rank: each byte goes to the
+  // number of bytes less than it, plus the equal bytes before it. One
+  // compare per byte against the whole word, and no branch on the data,
+  // which std::sort mispredicts on every few letters.
+  if (n <= 16) {
+    using namespace string_kernels_detail;
+    alignas(16) char bytes[16] = {};
+    std::memcpy(bytes, word.data(), n);
+    __m128i folded = fold16(load16(bytes));
+    _mm_store_si128(reinterpret_cast<__m128i *>(bytes), folded);
+    // Flipping the sign bit makes the signed compare order bytes unsigned.
+    const __m128i flip = _mm_set1_epi8(static_cast<char>(0x80));
+    const __m128i all = _mm_xor_si128(folded, flip);
+    const unsigned in_word = (1u << n) - 1;
+    for (size_t i = 0; i < n; ++i) {
+      __m128i b = _mm_xor_si128(_mm_set1_epi8(bytes[i]), flip);
+      unsigned less = _mm_movemask_epi8(_mm_cmpgt_epi8(b, all)) & in_word;
+      unsigned equal_before =
+          _mm_movemask_epi8(_mm_cmpeq_epi8(b, all)) & ((1u << i) - 1);
+      out[std::popcount(less) + std::popcount(equal_before)] = bytes[i];
+    }
+    return;
+  }
+#endif
+  for (size_t i = 0; i < n; ++i)
+    out[i] = fold_ascii_case(word[i]);
+  std::sort(out, out + n);
+}
+
+// A word's signature with its hash, computed once and carried through the
+// partitioning and the table.
+struct SignatureKey {
+  std::string_view text;
+  uint64_t hash = 0;
+  bool operator==(const SignatureKey &other) const {
+    return hash == other.hash && text == other.text;
+  }
+};
+
+struct SignatureHash {
+  uint64_t operator()(const SignatureKey &key) const { return key.hash; }
+};
+
+// What is partitioned: the key itself rather than an index to it, so that
+// grouping a partition reads its entries in order.
+struct Entry {
+  SignatureKey key;
+  uint32_t id = 0; // input position
+};
+
+} // namespace anagram_detail
+
+// Input bytes below which splitting the text into words is not worth a
+// thread.
+inline constexpr size_t kAnagramMinBytesPerThread = size_t(1) << 20;
+
+// Words per hash partition: small enough for the partition's table to stay
+// in cache.
+inline constexpr size_t kAnagramWordsPerPartition = size_t(1) << 14;
+
+class AnagramGroups {
+public:
+  // Groups the whitespace-separated words of `text`, using up to `threads`
+  // threads (0 = one per hardware thread). Throws std::length_error past
+  // 2^32 words.
+  static AnagramGroups FromText(std::string text, size_t threads = 0) {
+    AnagramGroups groups;
+    groups.text = std::make_unique<const std::string>(std::move(text));
+    groups.Build(threads);
+    return groups;
+  }
+
+  // Reads the whole file, then groups it as FromText. Throws
+  // std::runtime_error if it cannot be read.
+  static AnagramGroups FromFile(const std::string &path, size_t threads = 0) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+      throw std::runtime_error("cannot open " + path);
+    in.seekg(0, std::ios::end);
+    std::string text(static_cast<size_t>(in.tellg()), '\0');
+    in.seekg(0, std::ios::beg);
+    if (!in.read(text.data(), static_cast<std::streamsize>(text.size())))
+      throw std::runtime_error("cannot read " + path);
+    return FromText(std::move(text), threads);
+  }
+
+  // Groups a list of words, each taken whole (it may contain spaces).
+  static AnagramGroups FromWords(std::span<const std::string> words,
+                                 size_t threads = 0) {
+    AnagramGroups groups;
+    size_t bytes = 0;
+    for (const std::string &word : words)
+      bytes += word.size();
+    auto joined = std::make_unique<std::string>();
+    joined->reserve(bytes);
+    std::vector<std::string_view> views;
+    views.reserve(words.size());
+    for (const std::string &word : words)
+      joined->append(word);
+    size_t offset = 0;
+    for (const std::string &word : words) {
+      views.emplace_back(joined->data() + offset, word.size());
+      offset += word.size();
+    }
+    groups.text = std::move(joined);
+    groups.Assign(std::move(views), threads);
+    return groups;
+  }
+
+  size_t WordCount() const { return words.size(); }
+  size_t GroupCount() const { return bounds.size() - 1; }
+
+  // The words of group g, in input order. Throws std::out_of_range.
+  std::span<const std::string_view> Group(size_t g) const {
+    if (g >= GroupCount())
+      throw std::out_of_range("anagram group index out of range");
+    return std::span<const std::string_view>(words).subspan(
+        bounds[g], bounds[g + 1] - bounds[g]);
+  }
+
+  // Calls fn(std::span<const std::string_view>) for each group with at
+  // least min_size words, in group order. fn may return bool; returning
+  // false stops.
+  template <typename Fn> void ForEachGroup(Fn &&fn, size_t min_size = 1) const {
+    for (size_t g = 0; g < GroupCount(); ++g) {
+      if (bounds[g + 1] - bounds[g] < min_size)
+        continue;
+      if (!invoke_sink(fn, Group(g)))
+        return;
+    }
+  }
+
+  // Writes each group of at least min_size words on its own line, words
+  // separated by spaces. The default leaves out words with no anagram.
+  void Write(std::ostream &out, size_t min_size = 2) const {
+    ForEachGroup(
+        [&](std::span<const std::string_view> group) {
+          for (size_t i = 0; i < group.size(); ++i)
+            out << (i ? " " : "") << group[i];
+          out << '\n';
+        },
+        min_size);
+  }
+
+private:
+  // Heap-allocated so that moving the object keeps the views valid.
+  std::unique_ptr<const std::string> text;
+  std::vector<std::string_view> words; // grouped: group g is [bounds[g], bounds[g+1])
+  std::vector<size_t> bounds{0};
+
+  AnagramGroups() = default;
+
+  void Build(size_t threads) {
+    // Each thread splits a byte range, taking the words that start in it.
+    const std::string &t = *text;
+    const size_t parts = std::max<size_t>(
+        1, std::min(resolve_thread_count(threads),
+                    t.size() / kAnagramMinBytesPerThread));
+    std::vector<std::vector<std::string_view>> found(parts);
+    parallel_for(parts, [&](size_t p) {
+      size_t i = t.size() * p / parts, hi = t.size() * (p + 1) / parts;
+      // Skip the rest of a word that began in the previous range.
+      while (i > 0 && i < hi && !anagram_detail::IsSpace(t[i - 1]))
+        ++i;
+      while (i < hi) {
+        while (i < hi && anagram_detail::IsSpace(t[i]))
+          ++i;
+        if (i == hi)
+          break;
+        size_t j = i;
+        while (j < t.size() && !anagram_detail::IsSpace(t[j]))
+          ++j;
+        found[p].emplace_back(t.data() + i, j - i);
+        i = j;
+      }
+    });
+    std::vector<std::string_view> all;
+    if (parts == 1) {
+      all = std::move(found[0]);
+    } else {
+      for (const auto &part : found)
+        all.insert(all.end(), part.begin(), part.end());
+    }
+    Assign(std::move(all), threads);
+  }
+
+  // Groups `input`, whose views point into *text.
+  void Assign(std::vector<std::string_view> input, size_t threads) {
+    using anagram_detail::Entry;
+    const size_t n = input.size();
+    if (n > UINT32_MAX)
+      throw std::length_error("AnagramGroups holds at most 2^32 words");
+    const size_t workers = std::max<size_t>(
+        1, std::min(resolve_thread_count(threads), n / 4096));
+
+    // Signatures go to a second buffer at the same offsets as their words,
+    // so a signature also locates its word.
+    const char *base = text->data();
+    auto signatures = std::make_unique_for_overwrite<char[]>(text->size());
+    auto word_of = [&](std::string_view signature) {
+      return std::string_view(base + (signature.data() - signatures.get()),
+                              signature.size());
+    };
+    std::vector<Entry> entries(n);
+    parallel_for(workers, [&](size_t w) {
+      for (size_t i = n * w / workers; i < n * (w + 1) / workers; ++i) {
+        char *out = signatures.get() + (input[i].data() - base);
+        anagram_detail::Signature(input[i], out);
+        std::string_view signature(out, input[i].size());
+        entries[i] = {{signature, flat_hash_detail::Mix(std::hash<
+                                      std::string_view>{}(signature))},
+                      static_cast<uint32_t>(i)};
+      }
+    });
+    input = {};
+
+    // Radix-partition by signature hash; anagrams share a partition, and
+    // the stable scatter keeps each partition in input order.
+    std::vector<Entry> by_partition(n);
+    const unsigned bits = hash_partition_bits(n, kAnagramWordsPerPartition);
+    std::vector<size_t> partition_bounds = hash_partition(
+        entries.data(), n, bits, [](const Entry &e) { return e.key.hash; },
+        by_partition.data(), threads);
+    entries = {};
+
+    // Group each partition: local group ids in order of first appearance,
+    // then a counting sort of the partition's words by group.
+    struct GroupRef {
+      uint32_t first_word;
+      size_t begin;
+      size_t size;
+    };
+    const size_t partitions = partition_bounds.size() - 1;
+    std::vector<std::vector<GroupRef>> partition_groups(partitions);
+    std::vector<std::string_view> grouped(n);
+    std::atomic<size_t> next_partition{0};
+    parallel_for(std::min(workers, partitions), [&](size_t) {
+      std::vector<uint32_t> local_group;
+      std::vector<size_t> offsets;
+      for (size_t p; (p = next_partition.fetch_add(1)) < partitions;) {
+        const size_t lo = partition_bounds[p], hi = partition_bounds[p + 1];
+        FlatHashMap<anagram_detail::SignatureKey, uint32_t,
+                    anagram_detail::SignatureHash>
+            table(hi - lo);
+        std::vector<GroupRef> &refs = partition_groups[p];
+        local_group.resize(hi - lo);
+        for (size_t k = lo; k < hi; ++k) {
+          uint32_t &slot = table[by_partition[k].key]; // 0 until it exists
+          if (slot == 0) {
+            refs.push_back({by_partition[k].id, 0, 0});
+            slot = static_cast<uint32_t>(refs.size());
+          }
+          local_group[k - lo] = slot - 1;
+          ++refs[slot - 1].size;
+        }
+        offsets.resize(refs.size());
+        size_t offset = lo;
+        for (size_t g = 0; g < refs.size(); ++g) {
+          refs[g].begin = offsets[g] = offset;
+          offset += refs[g].size;
+        }
+        for (size_t k = lo; k < hi; ++k)
+          grouped[offsets[local_group[k - lo]]++] =
+              word_of(by_partition[k].key.text);
+      }
+    });
+
+    // Number the groups by first word, independent of the partitioning.
+    std::vector<GroupRef> all;
+    all.reserve(std::accumulate(
+        partition_groups.begin(), partition_groups.end(), size_t(0),
+        [](size_t sum, const auto &refs) { return sum + refs.size(); }));
+    for (const auto &refs : partition_groups)
+      all.insert(all.end(), refs.begin(), refs.end());
+    std::sort(all.begin(), all.end(),
+              [](const GroupRef &a, const GroupRef &b) {
+                return a.first_word < b.first_word;
+              });
+    words.clear();
+    words.reserve(n);
+    bounds.assign(1, 0);
+    bounds.reserve(all.size() + 1);
+    for (const GroupRef &ref : all) {
+      words.insert(words.end(), grouped.begin() + ref.begin,
+                   grouped.begin() + ref.begin + ref.size);
+      bounds.push_back(words.size());
+    }
+  }
+};
+
+#endif // ANAGRAM_GROUPS_H
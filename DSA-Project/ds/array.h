@@ -9,16 +9,122 @@
 #define ARRAY_H
 
 #include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <iostream>
+#include <iterator>
 #include <limits>
+#include <memory>
 #include <optional>
+#include <span>
 #include <stdexcept>
 #include <string>
-#include <unordered_map>
-#include <unordered_set>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
+#include "../algo/hash_partition.h"
+#include "../algo/loser_tree.h"
+#include "../algo/merge_path.h"
+#include "../algo/parallel.h"
+#include "../algo/presence_bitmap.h"
+#include "../algo/result_sink.h"
+#include "../algo/sequence_math.h"
+#include "../algo/set_kernels.h"
+#include "../algo/sort_network.h"
+#include "flat_hash.h"
+
+// Strategy used by NthElement to locate the k-th smallest element.
+enum class SelectAlgorithm {
+  Introselect, // quickselect with a median-of-medians fallback
+  FloydRivest  // sampling-based select, fewer comparisons on large inputs
+};
+
+// How Union, Intersection and Difference walk their inputs. Auto gallops when
+// one input is much larger than the other and otherwise uses the vectorized
+// kernels for arithmetic types.
+enum class SetStrategy {
+  Auto,
+  Linear,    // two-pointer merge, O(n + m)
+  Galloping, // exponential search through the larger input, O(m log(n / m))
+  Vectorized // branch-free merge; SIMD block compare for unique int32/uint32
+};
+
+// How FindDuplicates, FindMissing and PairWithSum answer a query. Auto picks
+// a plan from cheap statistics of the array; the others force one.
+enum class QueryPlan {
+  Auto,
+  BruteForce,      // compares every pair; only for a few dozen elements
+  SortedScan,      // one pass over an array that is already sorted
+  DirectAddress,   // bitmap or count table indexed by value - min (integers)
+  Hashing,         // one flat hash table
+  ParallelHashing, // hash-partitioned counting across hardware threads
+  SortedCopy       // sorts a copy of the array, then scans it
+};
+
+inline const char *QueryPlanName(QueryPlan plan) {
+  switch (plan) {
+  case QueryPlan::Auto:
+    return "Auto";
+  case QueryPlan::BruteForce:
+    return "BruteForce";
+  case QueryPlan::SortedScan:
+    return "SortedScan";
+  case QueryPlan::DirectAddress:
+    return "DirectAddress";
+  case QueryPlan::Hashing:
+    return "Hashing";
+  case QueryPlan::ParallelHashing:
+    return "ParallelHashing";
+  case QueryPlan::SortedCopy:
+    return "SortedCopy";
+  }
+  return "Unknown";
+}
+
+// A run of consecutive absent values [lo, hi), as reported by the
+// missing-element finders.
+template <typename T> struct MissingRange {
+  T lo;
+  T hi;
+  bool operator==(const MissingRange &) const = default;
+};
+
+// A value that occurs more than once, and how many times it occurs.
+template <typename T> struct DuplicateRun {
+  T value;
+  size_t count;
+  bool operator==(const DuplicateRun &) const = default;
+};
+
+// PairWithSum adds integers in a type that holds the sum of any two, so every
+// plan tests a + b == k exactly and none reports a pair whose sum only
+// matches k after wrapping around.
+template <typename T>
+using PairSum = std::conditional_t<
+    std::is_integral_v<T> && !std::is_same_v<T, bool>,
+    std::conditional_t<sizeof(T) <= 4, int64_t, __int128>, T>;
+
+// The value c with a + c == k exactly, if T can hold it.
+template <typename T>
+std::optional<T> PairComplement(const T &k, const T &a) {
+  if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>) {
+    PairSum<T> c = PairSum<T>(k) - PairSum<T>(a);
+    if (c < PairSum<T>(std::numeric_limits<T>::min()) ||
+        c > PairSum<T>(std::numeric_limits<T>::max()))
+      return std::nullopt;
+    return static_cast<T>(c);
+  } else {
+    return k - a;
+  }
+}
+
 // The template declaration applies to the whole class
 template <typename T> class Array {
 private:
@@ -29,6 +135,90 @@ private:
   void swap(T *x, T *y);
   void resize();
 
+  // --- Selection / Sorting Helpers (half-open ranges [lo, hi)) ---
+  void InsertionSortRange(size_t lo, size_t hi);
+  void HeapSortRange(size_t lo, size_t hi);
+  void SortLeaf(size_t lo, size_t hi);
+  void IntroSortRange(size_t lo, size_t hi, size_t depth);
+  std::pair<size_t, size_t> PartitionThreeWay(size_t lo, size_t hi,
+                                              size_t pivot_index);
+  size_t MedianOfThree(size_t a, size_t b, size_t c) const;
+  size_t MedianOfMedians(size_t lo, size_t hi);
+  void IntroSelect(size_t lo, size_t hi, size_t k);
+  void FloydRivestSelect(std::ptrdiff_t left, std::ptrdiff_t right,
+                         std::ptrdiff_t k);
+
+  // --- Set Operation Helpers ---
+  enum class SetOp { Merge, Union, Intersection, Difference };
+  static SetStrategy ResolveSetStrategy(const T *a, size_t na, const T *b,
+                                        size_t nb, SetStrategy strategy);
+  template <typename Out>
+  static size_t MergeCore(const T *a, size_t na, const T *b, size_t nb,
+                          Out out);
+  template <typename Out>
+  static size_t UnionCore(const T *a, size_t na, const T *b, size_t nb,
+                          Out out, SetStrategy path);
+  template <typename Out>
+  static size_t IntersectionCore(const T *a, size_t na, const T *b, size_t nb,
+                                 Out out, SetStrategy path);
+  template <typename Out>
+  static size_t DifferenceCore(const T *a, size_t na, const T *b, size_t nb,
+                               Out out, SetStrategy path);
+  static size_t UnionBuffer(const T *a, size_t na, const T *b, size_t nb,
+                            T *out, SetStrategy path);
+  static size_t IntersectionBuffer(const T *a, size_t na, const T *b,
+                                   size_t nb, T *out, SetStrategy path);
+  static size_t DifferenceBuffer(const T *a, size_t na, const T *b, size_t nb,
+                                 T *out, SetStrategy path);
+  static size_t SetResultBound(size_t na, size_t nb, SetOp op);
+  static std::pair<size_t, size_t> SetOpTail(const T *a, size_t na,
+                                             const T *b, size_t nb, SetOp op,
+                                             size_t want);
+  static size_t SetOpToBuffer(const T *a, size_t na, const T *b, size_t nb,
+                              T *out, SetOp op, SetStrategy strategy);
+  template <typename Out>
+  static size_t SetOpToIterator(const T *a, size_t na, const T *b, size_t nb,
+                                Out out, SetOp op, SetStrategy strategy);
+  Array<T> SetOpToArray(const Array<T> &arr2, SetOp op,
+                        SetStrategy strategy) const;
+  size_t SetOpInto(const Array<T> &arr2, Array<T> &out, SetOp op,
+                   SetStrategy strategy) const;
+  size_t SetOpInto(const Array<T> &arr2, std::span<T> out, SetOp op,
+                   SetStrategy strategy) const;
+  Array<T> ParallelSetOp(const Array<T> &arr2, SetOp op,
+                         size_t threads) const;
+
+  // --- Result Sink Helpers ---
+  template <typename R, typename Find>
+  static std::vector<R> CollectToVector(Find find);
+  template <typename R, typename Find>
+  static size_t CollectToSpan(std::span<R> out, Find find);
+  std::vector<DuplicateRun<T>> ParallelCount(size_t min_count,
+                                             size_t threads) const;
+  template <typename Count, typename Sink>
+  void CountDuplicatesHashing(Sink &sink) const;
+
+  // --- Query Dispatch Helpers ---
+  // What the planners look at: one isSorted pass, plus FindMinMax for
+  // unsorted integers.
+  struct QueryStats {
+    bool sorted = false;
+    T min{};
+    uint64_t range = 0; // max - min + 1 for integers (saturating), else 0
+  };
+  QueryStats GatherQueryStats() const;
+  // Auto picks from the statistics; SortedScan and DirectAddress are checked
+  // against them. The other plans apply to any array.
+  static bool NeedsQueryStats(QueryPlan plan) {
+    return plan == QueryPlan::Auto || plan == QueryPlan::SortedScan ||
+           plan == QueryPlan::DirectAddress;
+  }
+  // Turn Auto into a concrete plan, or check that a forced plan applies.
+  QueryPlan ResolveDuplicatesPlan(QueryPlan plan,
+                                  const QueryStats &stats) const;
+  QueryPlan ResolveMissingPlan(QueryPlan plan, const QueryStats &stats) const;
+  QueryPlan ResolvePairSumPlan(QueryPlan plan, const QueryStats &stats) const;
+
 public:
   // --- Iterator Support ---
   T *begin();
@@ -51,6 +241,7 @@ public:
   T Delete(size_t index);
   std::optional<T> Get(size_t index) const;
   void Set(size_t index, const T &x);
+  void Reserve(size_t capacity);
 
   // --- Search Operations ---
   std::optional<size_t> LinearSearch(const T &key);
@@ -70,24 +261,147 @@ public:
   void ReverseInPlace();
   void InsertSort(const T &x);
   void Rearrange();
+  void Sort();
+
+  // --- Selection Operations (Unsorted Arrays) ---
+  T NthElement(size_t k,
+               SelectAlgorithm algorithm = SelectAlgorithm::Introselect);
+  Array<T> TopK(size_t k) const;
+  void PartialSort(size_t k);
 
   // --- Set Operations (Require Sorted Arrays) ---
   Array<T> Merge(const Array<T> &arr2) const;
-  Array<T> Union(const Array<T> &arr2) const;
-  Array<T> Intersection(const Array<T> &arr2) const;
-  Array<T> Difference(const Array<T> &arr2) const;
+  Array<T> Union(const Array<T> &arr2,
+                 SetStrategy strategy = SetStrategy::Auto) const;
+  Array<T> Intersection(const Array<T> &arr2,
+                        SetStrategy strategy = SetStrategy::Auto) const;
+  Array<T> Difference(const Array<T> &arr2,
+                      SetStrategy strategy = SetStrategy::Auto) const;
+
+  // Allocation-free variants: write into `out` and return the count written.
+  size_t Merge(const Array<T> &arr2, Array<T> &out) const;
+  size_t Merge(const Array<T> &arr2, std::span<T> out) const;
+  template <std::output_iterator<const T &> OutputIt>
+  size_t Merge(const Array<T> &arr2, OutputIt out) const;
+  size_t Union(const Array<T> &arr2, Array<T> &out,
+               SetStrategy strategy = SetStrategy::Auto) const;
+  size_t Union(const Array<T> &arr2, std::span<T> out,
+               SetStrategy strategy = SetStrategy::Auto) const;
+  template <std::output_iterator<const T &> OutputIt>
+  size_t Union(const Array<T> &arr2, OutputIt out,
+               SetStrategy strategy = SetStrategy::Auto) const;
+  size_t Intersection(const Array<T> &arr2, Array<T> &out,
+                      SetStrategy strategy = SetStrategy::Auto) const;
+  size_t Intersection(const Array<T> &arr2, std::span<T> out,
+                      SetStrategy strategy = SetStrategy::Auto) const;
+  template <std::output_iterator<const T &> OutputIt>
+  size_t Intersection(const Array<T> &arr2, OutputIt out,
+                      SetStrategy strategy = SetStrategy::Auto) const;
+  size_t Difference(const Array<T> &arr2, Array<T> &out,
+                    SetStrategy strategy = SetStrategy::Auto) const;
+  size_t Difference(const Array<T> &arr2, std::span<T> out,
+                    SetStrategy strategy = SetStrategy::Auto) const;
+  template <std::output_iterator<const T &> OutputIt>
+  size_t Difference(const Array<T> &arr2, OutputIt out,
+                    SetStrategy strategy = SetStrategy::Auto) const;
+  void MergeWith(const Array<T> &arr2);
+
+  // Multi-threaded versions; `threads` == 0 uses every hardware thread. The
+  // result is identical to the single-threaded call.
+  Array<T> ParallelMerge(const Array<T> &arr2, size_t threads = 0) const;
+  Array<T> ParallelUnion(const Array<T> &arr2, size_t threads = 0) const;
+  Array<T> ParallelIntersection(const Array<T> &arr2,
+                                size_t threads = 0) const;
+  Array<T> ParallelDifference(const Array<T> &arr2, size_t threads = 0) const;
+
+  // K-way versions of Merge, Union and Intersection over many sorted arrays.
+  static Array<T> MergeAll(std::span<const Array<T>> arrays);
+  static Array<T> UnionAll(std::span<const Array<T>> arrays);
+  static Array<T> IntersectAll(std::span<const Array<T>> arrays);
 
   // --- Numeric-Specific Algorithms ---
+  // The multiple-missing and duplicate finders report their results to a
+  // sink callback, into a caller's span (returns the count, throws
+  // std::length_error if it fills up), or with no argument as a new vector.
   std::optional<T> FindSingleMissingElementSorted() const;
-  void FindMultipleMissingElementsSorted() const;
   std::optional<T> FindSingleMissingElementUnsortedOptimal() const;
-  void FindMultipleMissingElementsHash() const;
-  void FindDuplicatesSorted() const;
-  void FindDuplicatesHashing() const;
+
+  // Gaps between the smallest and largest values, as [lo, hi) ranges in
+  // increasing order. The Sorted version requires a sorted array.
+  std::vector<MissingRange<T>> FindMultipleMissingElementsSorted() const;
+  size_t
+  FindMultipleMissingElementsSorted(std::span<MissingRange<T>> out) const;
+  template <ResultSink<MissingRange<T>> Sink>
+  void FindMultipleMissingElementsSorted(Sink &&sink) const;
+  // The Hash version marks a presence bitmap, in windows of
+  // kPresenceChunkBits values for wide ranges. `threads` > 1 splits the
+  // marking of each window (0 = one thread per hardware thread).
+  std::vector<MissingRange<T>>
+  FindMultipleMissingElementsHash(size_t threads = 1) const;
+  size_t FindMultipleMissingElementsHash(std::span<MissingRange<T>> out,
+                                         size_t threads = 1) const;
+  template <ResultSink<MissingRange<T>> Sink>
+  void FindMultipleMissingElementsHash(Sink &&sink, size_t threads = 1) const;
+
+  // Values occurring more than once with their counts. The Sorted version
+  // requires a sorted array and reports in value order; Hashing reports in
+  // order of first occurrence.
+  std::vector<DuplicateRun<T>> FindDuplicatesSorted() const;
+  size_t FindDuplicatesSorted(std::span<DuplicateRun<T>> out) const;
+  template <ResultSink<DuplicateRun<T>> Sink>
+  void FindDuplicatesSorted(Sink &&sink) const;
+  std::vector<DuplicateRun<T>> FindDuplicatesHashing() const;
+  size_t FindDuplicatesHashing(std::span<DuplicateRun<T>> out) const;
+  template <ResultSink<DuplicateRun<T>> Sink>
+  void FindDuplicatesHashing(Sink &&sink) const;
+
+  // Multi-threaded counting for large unsorted arrays (`threads` == 0 uses
+  // every hardware thread). Values are radix-partitioned by hash into
+  // cache-sized groups, and each group is counted in its own small table.
+  // Results are grouped by partition and in first-occurrence order within
+  // each, an order that depends on the input but not on `threads`.
+  std::vector<DuplicateRun<T>> ParallelFindDuplicates(size_t threads = 0) const;
+  // Every distinct value with its count, including values seen once.
+  std::vector<DuplicateRun<T>>
+  ParallelCountFrequencies(size_t threads = 0) const;
+
   std::vector<std::pair<T, int>> FindDuplicatesUnsorted_BruteForce();
   std::optional<std::pair<T, T>> PairWithSum_Sorted(const T &k) const;
   std::optional<std::pair<T, T>> PairWithSum_Hashing(const T &k) const;
   std::optional<std::pair<T, T>> FindMinMax() const;
+
+  // --- Query Dispatch ---
+  // One entry point per query, which picks the method from the length,
+  // whether the array is sorted, and the value range from FindMinMax. Pass a
+  // QueryPlan to force a method; one that does not apply to the query, the
+  // element type or the array (SortedScan on an unsorted array) throws
+  // std::invalid_argument. Plan*() report what Auto would choose for the
+  // array as it is now.
+  QueryPlan PlanFindDuplicates() const;
+  QueryPlan PlanFindMissing() const;
+  QueryPlan PlanPairWithSum() const;
+
+  // Duplicates in increasing value order, whatever the plan.
+  std::vector<DuplicateRun<T>>
+  FindDuplicates(QueryPlan plan = QueryPlan::Auto) const;
+  size_t FindDuplicates(std::span<DuplicateRun<T>> out,
+                        QueryPlan plan = QueryPlan::Auto) const;
+  template <ResultSink<DuplicateRun<T>> Sink>
+  void FindDuplicates(Sink &&sink, QueryPlan plan = QueryPlan::Auto) const;
+
+  // Gaps between the smallest and largest values, in increasing order.
+  // Integers only.
+  std::vector<MissingRange<T>>
+  FindMissing(QueryPlan plan = QueryPlan::Auto) const;
+  size_t FindMissing(std::span<MissingRange<T>> out,
+                     QueryPlan plan = QueryPlan::Auto) const;
+  template <ResultSink<MissingRange<T>> Sink>
+  void FindMissing(Sink &&sink, QueryPlan plan = QueryPlan::Auto) const;
+
+  // Some pair of elements summing to k. Which pair is found when there are
+  // several depends on the plan.
+  std::optional<std::pair<T, T>>
+  PairWithSum(const T &k, QueryPlan plan = QueryPlan::Auto) const;
 };
 
 // =================================================================================
@@ -117,6 +431,198 @@ template <typename T> void Array<T>::resize() {
   size = newSize;
 }
 
+// Ranges at or below this size are finished with insertion sort; partitioning
+// them costs more than it saves.
+inline constexpr size_t kSelectInsertionCutoff = 16;
+
+// Leaf size for IntroSortRange. Types with a vectorized sorting network hand
+// whole leaves to it, which is cheaper than partitioning down to 16.
+template <typename T> constexpr size_t SortLeafCutoff() {
+  if constexpr (has_sort_network<T> && kSortNetworkVectorized)
+    return kSortNetworkMaxSize;
+  else
+    return kSelectInsertionCutoff;
+}
+
+inline size_t FloorLog2(size_t n) {
+  size_t log = 0;
+  while (n > 1) {
+    n >>= 1;
+    ++log;
+  }
+  return log;
+}
+
+template <typename T>
+void Array<T>::InsertionSortRange(size_t lo, size_t hi) {
+  for (size_t i = lo + 1; i < hi; ++i) {
+    T x = A[i];
+    size_t j = i;
+    while (j > lo && x < A[j - 1]) {
+      A[j] = A[j - 1];
+      j--;
+    }
+    A[j] = x;
+  }
+}
+
+template <typename T> void Array<T>::SortLeaf(size_t lo, size_t hi) {
+  if constexpr (has_sort_network<T> && kSortNetworkVectorized)
+    sort_network(A + lo, hi - lo);
+  else
+    InsertionSortRange(lo, hi);
+}
+
+template <typename T> void Array<T>::HeapSortRange(size_t lo, size_t hi) {
+  std::make_heap(A + lo, A + hi);
+  std::sort_heap(A + lo, A + hi);
+}
+
+template <typename T>
+void Array<T>::IntroSortRange(size_t lo, size_t hi, size_t depth) {
+  while (hi - lo > SortLeafCutoff<T>()) {
+    if (depth == 0) {
+      // Too many unbalanced partitions: heap sort bounds the worst case.
+      HeapSortRange(lo, hi);
+      return;
+    }
+    depth--;
+    size_t pivot = MedianOfThree(lo, lo + (hi - lo) / 2, hi - 1);
+    auto [lt, gt] = PartitionThreeWay(lo, hi, pivot);
+    // Recurse into the smaller side and loop on the larger one so the stack
+    // depth stays O(log n).
+    if (lt - lo < hi - gt) {
+      IntroSortRange(lo, lt, depth);
+      lo = gt;
+    } else {
+      IntroSortRange(gt, hi, depth);
+      hi = lt;
+    }
+  }
+  SortLeaf(lo, hi);
+}
+
+// Dutch national flag partition around A[pivot_index]. Returns [lt, gt), the
+// run of elements equal to the pivot, so inputs full of duplicates still
+// shrink on every pass.
+template <typename T>
+std::pair<size_t, size_t> Array<T>::PartitionThreeWay(size_t lo, size_t hi,
+                                                      size_t pivot_index) {
+  T pivot = A[pivot_index];
+  size_t lt = lo, i = lo, gt = hi;
+  while (i < gt) {
+    if (A[i] < pivot)
+      swap(&A[lt++], &A[i++]);
+    else if (pivot < A[i])
+      swap(&A[i], &A[--gt]);
+    else
+      i++;
+  }
+  return {lt, gt};
+}
+
+template <typename T>
+size_t Array<T>::MedianOfThree(size_t a, size_t b, size_t c) const {
+  if (A[a] < A[b]) {
+    if (A[b] < A[c])
+      return b;
+    return (A[a] < A[c]) ? c : a;
+  }
+  if (A[a] < A[c])
+    return a;
+  return (A[b] < A[c]) ? c : b;
+}
+
+// Groups of five: sort each group, gather the group medians at the front and
+// select their median. The result is guaranteed to split the range 30/70.
+template <typename T> size_t Array<T>::MedianOfMedians(size_t lo, size_t hi) {
+  if (hi - lo <= 5) {
+    InsertionSortRange(lo, hi);
+    return lo + (hi - lo) / 2;
+  }
+  size_t store = lo;
+  for (size_t g = lo; g < hi; g += 5) {
+    size_t g_end = std::min(g + 5, hi);
+    InsertionSortRange(g, g_end);
+    swap(&A[store++], &A[g + (g_end - g) / 2]);
+  }
+  size_t mid = lo + (store - lo) / 2;
+  IntroSelect(lo, store, mid);
+  return mid;
+}
+
+template <typename T>
+void Array<T>::IntroSelect(size_t lo, size_t hi, size_t k) {
+  // Quickselect with a depth budget. Once the budget runs out the pivot comes
+  // from median-of-medians, which keeps the worst case linear.
+  size_t depth = 2 * FloorLog2(hi - lo);
+  while (hi - lo > kSelectInsertionCutoff) {
+    size_t pivot;
+    if (depth == 0) {
+      pivot = MedianOfMedians(lo, hi);
+    } else {
+      depth--;
+      pivot = MedianOfThree(lo, lo + (hi - lo) / 2, hi - 1);
+    }
+    auto [lt, gt] = PartitionThreeWay(lo, hi, pivot);
+    if (k < lt)
+      hi = lt;
+    else if (k >= gt)
+      lo = gt;
+    else
+      return; // k landed in the run of pivot-equal elements
+  }
+  InsertionSortRange(lo, hi);
+}
+
+// Floyd & Rivest, "Algorithm 489: SELECT" (CACM 1975). Recursively selects
+// from a small sample to pick two pivots that bracket k tightly, so most
+// elements are compared about once. Bounds are inclusive.
+template <typename T>
+void Array<T>::FloydRivestSelect(std::ptrdiff_t left, std::ptrdiff_t right,
+                                 std::ptrdiff_t k) {
+  while (right > left) {
+    if (right - left > 600) {
+      double n = static_cast<double>(right - left + 1);
+      double i = static_cast<double>(k - left + 1);
+      double z = std::log(n);
+      double s = 0.5 * std::exp(2 * z / 3);
+      double sd = 0.5 * std::sqrt(z * s * (n - s) / n) * (i < n / 2 ? -1 : 1);
+      std::ptrdiff_t new_left = std::max(
+          left, static_cast<std::ptrdiff_t>(static_cast<double>(k) -
+                                            i * s / n + sd));
+      std::ptrdiff_t new_right = std::min(
+          right, static_cast<std::ptrdiff_t>(static_cast<double>(k) +
+                                             (n - i) * s / n + sd));
+      FloydRivestSelect(new_left, new_right, k);
+    }
+    T t = A[k];
+    std::ptrdiff_t i = left, j = right;
+    swap(&A[left], &A[k]);
+    if (t < A[right])
+      swap(&A[right], &A[left]);
+    while (i < j) {
+      swap(&A[i], &A[j]);
+      i++;
+      j--;
+      while (A[i] < t)
+        i++;
+      while (t < A[j])
+        j--;
+    }
+    if (!(A[left] < t) && !(t < A[left])) {
+      swap(&A[left], &A[j]);
+    } else {
+      j++;
+      swap(&A[j], &A[right]);
+    }
+    if (j <= k)
+      left = j + 1;
+    if (k <= j)
+      right = j - 1;
+  }
+}
+
 // --- Iterator Implementations ---
 
 template <typename T> T *Array<T>::begin() { return A; }
@@ -257,6 +763,18 @@ template <typename T> void Array<T>::Set(size_t index, const T &x) {
   A[index] = x;
 }
 
+// Grows the buffer to hold at least `capacity` elements; never shrinks.
+template <typename T> void Array<T>::Reserve(size_t capacity) {
+  if (capacity <= size)
+    return;
+  T *newA = new T[capacity];
+  for (size_t i = 0; i < length; ++i)
+    newA[i] = std::move(A[i]);
+  delete[] A;
+  A = newA;
+  size = capacity;
+}
+
 template <typename T>
 std::optional<size_t> Array<T>::LinearSearch(const T &key) {
   for (size_t i = 0; i < length; i++) {
@@ -369,6 +887,14 @@ template <typename T> void Array<T>::InsertSort(const T &x) {
   length++;
 }
 
+// Sorts the whole array in ascending order with introsort. Arrays of up to 64
+// int32/float/int64 values go straight to a sorting network.
+template <typename T> void Array<T>::Sort() {
+  if (length < 2)
+    return;
+  IntroSortRange(0, length, 2 * FloorLog2(length));
+}
+
 template <typename T> void Array<T>::Rearrange() {
   if (length < 2)
     return;
@@ -383,97 +909,898 @@ template <typename T> void Array<T>::Rearrange() {
   }
 }
 
-template <typename T> Array<T> Array<T>::Merge(const Array<T> &arr2) const {
-  Array<T> arr3(length + arr2.length);
-  size_t i = 0, j = 0, k = 0;
-  while (i < length && j < arr2.length) {
-    arr3.A[k++] = (A[i] <= arr2.A[j]) ? A[i++] : arr2.A[j++];
-  }
-  while (i < length)
-    arr3.A[k++] = A[i++];
-  while (j < arr2.length)
-    arr3.A[k++] = arr2.A[j++];
-  arr3.length = k;
-  return arr3;
+// Reorders the array so A[k] holds the k-th smallest value (0-based), with
+// nothing larger before it and nothing smaller after it. Expected O(n).
+template <typename T>
+T Array<T>::NthElement(size_t k, SelectAlgorithm algorithm) {
+  if (k >= length) {
+    throw std::out_of_range("Index out of bounds for NthElement.");
+  }
+  if (algorithm == SelectAlgorithm::FloydRivest) {
+    FloydRivestSelect(0, static_cast<std::ptrdiff_t>(length) - 1,
+                      static_cast<std::ptrdiff_t>(k));
+  } else {
+    IntroSelect(0, length, k);
+  }
+  return A[k];
 }
 
-template <typename T> Array<T> Array<T>::Union(const Array<T> &arr2) const {
-  Array<T> arr3(length + arr2.length);
-  size_t i = 0, j = 0, k = 0;
-  while (i < length && j < arr2.length) {
-    if (A[i] < arr2.A[j])
-      arr3.A[k++] = A[i++];
-    else if (arr2.A[j] < A[i])
-      arr3.A[k++] = arr2.A[j++];
+// Returns the k largest values in descending order without modifying the
+// array. A size-k min-heap holds the current winners, so the scan costs
+// O(n log k) time and O(k) extra space.
+template <typename T> Array<T> Array<T>::TopK(size_t k) const {
+  k = std::min(k, length);
+  Array<T> result(k);
+  if (k == 0)
+    return result;
+
+  std::vector<T> heap(A, A + k);
+  std::make_heap(heap.begin(), heap.end(), std::greater<T>());
+  for (size_t i = k; i < length; ++i) {
+    // heap.front() is the smallest winner; only larger values can displace it.
+    if (heap.front() < A[i]) {
+      std::pop_heap(heap.begin(), heap.end(), std::greater<T>());
+      heap.back() = A[i];
+      std::push_heap(heap.begin(), heap.end(), std::greater<T>());
+    }
+  }
+  std::sort_heap(heap.begin(), heap.end(), std::greater<T>());
+  for (const T &value : heap)
+    result.A[result.length++] = value;
+  return result;
+}
+
+// Places the k smallest values at the front in ascending order; the order of
+// the remaining elements is unspecified. O(n + k log k).
+template <typename T> void Array<T>::PartialSort(size_t k) {
+  k = std::min(k, length);
+  if (k == 0)
+    return;
+  if (k == length) {
+    IntroSortRange(0, length, 2 * FloorLog2(length));
+    return;
+  }
+  // After selection A[k - 1] is final and everything before it is no larger.
+  IntroSelect(0, length, k - 1);
+  IntroSortRange(0, k - 1, 2 * FloorLog2(k));
+}
+
+// Output iterator over a caller's span that throws instead of writing past
+// its end. Used when the span is smaller than the worst-case result.
+template <typename T> class SpanWriter {
+public:
+  using difference_type = std::ptrdiff_t;
+  using value_type = T;
+
+  SpanWriter() = default;
+  explicit SpanWriter(std::span<T> out)
+      : cur(out.data()), last(out.data() + out.size()) {}
+
+  T &operator*() const {
+    if (cur == last)
+      throw std::length_error("Output span is too small for the result.");
+    return *cur;
+  }
+  SpanWriter &operator++() {
+    ++cur;
+    return *this;
+  }
+  SpanWriter operator++(int) {
+    SpanWriter before = *this;
+    ++cur;
+    return before;
+  }
+
+private:
+  T *cur = nullptr;
+  T *last = nullptr;
+};
+
+// Output iterator that drops what is written. The set-operation cores run
+// through it to count a result without storing it.
+template <typename T> class DiscardWriter {
+public:
+  using difference_type = std::ptrdiff_t;
+  using value_type = T;
+
+  DiscardWriter &operator*() { return *this; }
+  DiscardWriter &operator=(const T &) { return *this; }
+  DiscardWriter &operator++() { return *this; }
+  DiscardWriter operator++(int) { return *this; }
+};
+
+// Once one input is this many times larger than the other, galloping through
+// it beats stepping through it one element at a time.
+inline constexpr size_t kGallopRatio = 32;
+
+// Turns Auto into a concrete strategy. Vectorized falls back to Linear for
+// types the kernels in set_kernels.h do not cover.
+template <typename T>
+SetStrategy Array<T>::ResolveSetStrategy(const T *a, size_t na, const T *b,
+                                         size_t nb, SetStrategy strategy) {
+  if (strategy == SetStrategy::Auto) {
+    size_t small = std::min(na, nb);
+    size_t large = std::max(na, nb);
+    if (small > 0 && large / small >= kGallopRatio)
+      return SetStrategy::Galloping;
+    strategy = SetStrategy::Linear;
+    if constexpr (std::is_arithmetic_v<T>) {
+      // Clustered inputs keep the branchy merge well predicted; only switch
+      // when a quick probe says the inputs interleave.
+      if (merge_favors_branchless(a, na, b, nb))
+        strategy = SetStrategy::Vectorized;
+    }
+  }
+  if (strategy == SetStrategy::Vectorized && !std::is_arithmetic_v<T>)
+    return SetStrategy::Linear;
+  return strategy;
+}
+
+// --- Set operation cores ---
+// The cores work on raw sorted ranges a[0, na) and b[0, nb) so that the
+// parallel versions can run them on slices. Each *Core writes through any
+// output iterator and handles the Linear and Galloping paths. Each *Buffer
+// writes to raw storage with room for the worst-case result plus
+// kSimdSetOutputSlack, which the vectorized kernels need. The public
+// overloads below only pick the storage.
+
+template <typename T>
+template <typename Out>
+size_t Array<T>::MergeCore(const T *a, size_t na, const T *b, size_t nb,
+                           Out out) {
+  size_t i = 0, j = 0;
+  while (i < na && j < nb) {
+    *out++ = (a[i] <= b[j]) ? a[i++] : b[j++];
+  }
+  out = std::copy(a + i, a + na, out);
+  std::copy(b + j, b + nb, out);
+  return na + nb;
+}
+
+template <typename T>
+template <typename Out>
+size_t Array<T>::UnionCore(const T *a, size_t na, const T *b, size_t nb,
+                           Out out, SetStrategy path) {
+  size_t k = 0;
+  if (path == SetStrategy::Galloping) {
+    // Copy the larger input in blocks between the smaller input's values.
+    bool a_is_small = na <= nb;
+    const T *small = a_is_small ? a : b, *large = a_is_small ? b : a;
+    size_t n_small = a_is_small ? na : nb, n_large = a_is_small ? nb : na;
+    size_t pos = 0;
+    for (size_t s = 0; s < n_small; ++s) {
+      size_t p = gallop_lower_bound(large, pos, n_large, small[s]);
+      out = std::copy(large + pos, large + p, out);
+      k += p - pos;
+      pos = p;
+      if (pos < n_large && !(small[s] < large[pos])) {
+        *out++ = a_is_small ? small[s] : large[pos];
+        pos++;
+      } else {
+        *out++ = small[s];
+      }
+      k++;
+    }
+    std::copy(large + pos, large + n_large, out);
+    return k + (n_large - pos);
+  }
+  size_t i = 0, j = 0;
+  while (i < na && j < nb) {
+    if (a[i] < b[j])
+      *out++ = a[i++];
+    else if (b[j] < a[i])
+      *out++ = b[j++];
     else {
-      arr3.A[k++] = A[i++];
+      *out++ = a[i++];
       j++;
     }
+    k++;
   }
-  while (i < length)
-    arr3.A[k++] = A[i++];
-  while (j < arr2.length)
-    arr3.A[k++] = arr2.A[j++];
-  arr3.length = k;
-  return arr3;
+  out = std::copy(a + i, a + na, out);
+  std::copy(b + j, b + nb, out);
+  return k + (na - i) + (nb - j);
 }
 
 template <typename T>
-Array<T> Array<T>::Intersection(const Array<T> &arr2) const {
-  Array<T> arr3(std::min(length, arr2.length));
-  size_t i = 0, j = 0, k = 0;
-  while (i < length && j < arr2.length) {
-    if (A[i] < arr2.A[j])
+template <typename Out>
+size_t Array<T>::IntersectionCore(const T *a, size_t na, const T *b,
+                                  size_t nb, Out out, SetStrategy path) {
+  size_t k = 0;
+  if (path == SetStrategy::Galloping) {
+    // Walk the smaller input and gallop through the larger one. Matches
+    // consume one element of each side, like the linear merge, and the
+    // emitted value always comes from a.
+    bool a_is_small = na <= nb;
+    const T *small = a_is_small ? a : b, *large = a_is_small ? b : a;
+    size_t n_small = a_is_small ? na : nb, n_large = a_is_small ? nb : na;
+    size_t pos = 0;
+    for (size_t s = 0; s < n_small && pos < n_large; ++s) {
+      pos = gallop_lower_bound(large, pos, n_large, small[s]);
+      if (pos < n_large && !(small[s] < large[pos])) {
+        *out++ = a_is_small ? small[s] : large[pos];
+        pos++;
+        k++;
+      }
+    }
+    return k;
+  }
+  size_t i = 0, j = 0;
+  while (i < na && j < nb) {
+    if (a[i] < b[j])
       i++;
-    else if (arr2.A[j] < A[i])
+    else if (b[j] < a[i])
       j++;
     else {
-      arr3.A[k++] = A[i++];
+      *out++ = a[i++];
       j++;
+      k++;
     }
   }
-  arr3.length = k;
-  return arr3;
+  return k;
 }
 
 template <typename T>
-Array<T> Array<T>::Difference(const Array<T> &arr2) const {
-  Array<T> arr3(length);
+template <typename Out>
+size_t Array<T>::DifferenceCore(const T *a, size_t na, const T *b, size_t nb,
+                                Out out, SetStrategy path) {
   size_t i = 0, j = 0, k = 0;
-  while (i < length && j < arr2.length) {
-    if (A[i] < arr2.A[j])
-      arr3.A[k++] = A[i++];
-    else if (arr2.A[j] < A[i])
+  if (path == SetStrategy::Galloping) {
+    if (nb <= na) {
+      // Few removals: gallop to each one and block-copy the survivors.
+      for (; j < nb && i < na; ++j) {
+        size_t p = gallop_lower_bound(a, i, na, b[j]);
+        out = std::copy(a + i, a + p, out);
+        k += p - i;
+        i = p;
+        if (i < na && !(b[j] < a[i]))
+          i++; // equal: drop one copy
+      }
+    } else {
+      // Few survivors: gallop through b looking for each one.
+      for (; i < na; ++i) {
+        j = gallop_lower_bound(b, j, nb, a[i]);
+        if (j < nb && !(a[i] < b[j])) {
+          j++;
+        } else {
+          *out++ = a[i];
+          k++;
+        }
+      }
+    }
+    std::copy(a + i, a + na, out);
+    return k + (na - i);
+  }
+  while (i < na && j < nb) {
+    if (a[i] < b[j]) {
+      *out++ = a[i++];
+      k++;
+    } else if (b[j] < a[i])
       j++;
     else {
       i++;
       j++;
     }
   }
-  while (i < length)
-    arr3.A[k++] = A[i++];
-  arr3.length = k;
+  std::copy(a + i, a + na, out);
+  return k + (na - i);
+}
+
+template <typename T>
+size_t Array<T>::UnionBuffer(const T *a, size_t na, const T *b, size_t nb,
+                             T *out, SetStrategy path) {
+  if constexpr (std::is_arithmetic_v<T>) {
+    if (path == SetStrategy::Vectorized)
+      return union_branchless(a, na, b, nb, out);
+  }
+  return UnionCore(a, na, b, nb, out, path);
+}
+
+template <typename T>
+size_t Array<T>::IntersectionBuffer(const T *a, size_t na, const T *b,
+                                    size_t nb, T *out, SetStrategy path) {
+  if constexpr (std::is_arithmetic_v<T>) {
+    if (path == SetStrategy::Vectorized) {
+      if constexpr (has_simd_set_ops<T>) {
+        // The block compare assumes unique values; check before using it.
+        if (is_strictly_increasing(a, na) && is_strictly_increasing(b, nb))
+          return intersect_simd(a, na, b, nb, out);
+      }
+      return intersect_branchless(a, na, b, nb, out);
+    }
+  }
+  return IntersectionCore(a, na, b, nb, out, path);
+}
+
+template <typename T>
+size_t Array<T>::DifferenceBuffer(const T *a, size_t na, const T *b,
+                                  size_t nb, T *out, SetStrategy path) {
+  if constexpr (std::is_arithmetic_v<T>) {
+    if (path == SetStrategy::Vectorized) {
+      if constexpr (has_simd_set_ops<T>) {
+        if (is_strictly_increasing(a, na) && is_strictly_increasing(b, nb))
+          return difference_simd(a, na, b, nb, out);
+      }
+      return difference_branchless(a, na, b, nb, out);
+    }
+  }
+  return DifferenceCore(a, na, b, nb, out, path);
+}
+
+// Worst-case result sizes, plus room for the vectorized kernels' overrun.
+template <typename T>
+size_t Array<T>::SetResultBound(size_t na, size_t nb, SetOp op) {
+  size_t bound = 0;
+  switch (op) {
+  case SetOp::Merge:
+  case SetOp::Union:
+    bound = na + nb;
+    break;
+  case SetOp::Intersection:
+    bound = std::min(na, nb);
+    break;
+  case SetOp::Difference:
+    bound = na;
+    break;
+  }
+  return bound + kSimdSetOutputSlack;
+}
+
+template <typename T>
+size_t Array<T>::SetOpToBuffer(const T *a, size_t na, const T *b, size_t nb,
+                               T *out, SetOp op, SetStrategy strategy) {
+  SetStrategy path = ResolveSetStrategy(a, na, b, nb, strategy);
+  switch (op) {
+  case SetOp::Merge:
+    return MergeCore(a, na, b, nb, out);
+  case SetOp::Union:
+    return UnionBuffer(a, na, b, nb, out, path);
+  case SetOp::Intersection:
+    return IntersectionBuffer(a, na, b, nb, out, path);
+  case SetOp::Difference:
+    return DifferenceBuffer(a, na, b, nb, out, path);
+  }
+  return 0;
+}
+
+template <typename T>
+template <typename Out>
+size_t Array<T>::SetOpToIterator(const T *a, size_t na, const T *b,
+                                 size_t nb, Out out, SetOp op,
+                                 SetStrategy strategy) {
+  // Arbitrary iterators have no slack for the SIMD kernels.
+  SetStrategy path = ResolveSetStrategy(a, na, b, nb, strategy);
+  if (path == SetStrategy::Vectorized)
+    path = SetStrategy::Linear;
+  switch (op) {
+  case SetOp::Merge:
+    return MergeCore(a, na, b, nb, out);
+  case SetOp::Union:
+    return UnionCore(a, na, b, nb, out, path);
+  case SetOp::Intersection:
+    return IntersectionCore(a, na, b, nb, out, path);
+  case SetOp::Difference:
+    return DifferenceCore(a, na, b, nb, out, path);
+  }
+  return 0;
+}
+
+template <typename T>
+Array<T> Array<T>::SetOpToArray(const Array<T> &arr2, SetOp op,
+                                SetStrategy strategy) const {
+  Array<T> arr3(SetResultBound(length, arr2.length, op));
+  arr3.length =
+      SetOpToBuffer(A, length, arr2.A, arr2.length, arr3.A, op, strategy);
   return arr3;
 }
 
-template <typename T> void Array<T>::FindDuplicatesHashing() const {
+template <typename T>
+size_t Array<T>::SetOpInto(const Array<T> &arr2, Array<T> &out, SetOp op,
+                           SetStrategy strategy) const {
+  if (&out == this || &out == &arr2) {
+    // Writing over an input while reading it would corrupt the result.
+    out = SetOpToArray(arr2, op, strategy);
+    return out.length;
+  }
+  out.length = 0;
+  out.Reserve(SetResultBound(length, arr2.length, op));
+  out.length =
+      SetOpToBuffer(A, length, arr2.A, arr2.length, out.A, op, strategy);
+  return out.length;
+}
+
+template <typename T>
+size_t Array<T>::SetOpInto(const Array<T> &arr2, std::span<T> out, SetOp op,
+                           SetStrategy strategy) const {
+  if (out.size() >= SetResultBound(length, arr2.length, op))
+    return SetOpToBuffer(A, length, arr2.A, arr2.length, out.data(), op,
+                         strategy);
+  return SetOpToIterator(A, length, arr2.A, arr2.length, SpanWriter<T>(out),
+                         op, strategy);
+}
+
+// --- Set operations: new Array results ---
+
+template <typename T> Array<T> Array<T>::Merge(const Array<T> &arr2) const {
+  return SetOpToArray(arr2, SetOp::Merge, SetStrategy::Linear);
+}
+
+template <typename T>
+Array<T> Array<T>::Union(const Array<T> &arr2, SetStrategy strategy) const {
+  return SetOpToArray(arr2, SetOp::Union, strategy);
+}
+
+template <typename T>
+Array<T> Array<T>::Intersection(const Array<T> &arr2,
+                                SetStrategy strategy) const {
+  return SetOpToArray(arr2, SetOp::Intersection, strategy);
+}
+
+template <typename T>
+Array<T> Array<T>::Difference(const Array<T> &arr2,
+                              SetStrategy strategy) const {
+  return SetOpToArray(arr2, SetOp::Difference, strategy);
+}
+
+// --- Set operations: caller-provided output ---
+// The Array& overloads reuse the target's buffer, growing it at most once to
+// the worst-case size. The span overloads never allocate and throw
+// std::length_error if the result does not fit. All return the count written.
+
+template <typename T>
+size_t Array<T>::Merge(const Array<T> &arr2, Array<T> &out) const {
+  return SetOpInto(arr2, out, SetOp::Merge, SetStrategy::Linear);
+}
+
+template <typename T>
+size_t Array<T>::Merge(const Array<T> &arr2, std::span<T> out) const {
+  return SetOpInto(arr2, out, SetOp::Merge, SetStrategy::Linear);
+}
+
+template <typename T>
+template <std::output_iterator<const T &> OutputIt>
+size_t Array<T>::Merge(const Array<T> &arr2, OutputIt out) const {
+  return SetOpToIterator(A, length, arr2.A, arr2.length, out, SetOp::Merge,
+                         SetStrategy::Linear);
+}
+
+template <typename T>
+size_t Array<T>::Union(const Array<T> &arr2, Array<T> &out,
+                       SetStrategy strategy) const {
+  return SetOpInto(arr2, out, SetOp::Union, strategy);
+}
+
+template <typename T>
+size_t Array<T>::Union(const Array<T> &arr2, std::span<T> out,
+                       SetStrategy strategy) const {
+  return SetOpInto(arr2, out, SetOp::Union, strategy);
+}
+
+template <typename T>
+template <std::output_iterator<const T &> OutputIt>
+size_t Array<T>::Union(const Array<T> &arr2, OutputIt out,
+                       SetStrategy strategy) const {
+  return SetOpToIterator(A, length, arr2.A, arr2.length, out, SetOp::Union,
+                         strategy);
+}
+
+template <typename T>
+size_t Array<T>::Intersection(const Array<T> &arr2, Array<T> &out,
+                              SetStrategy strategy) const {
+  return SetOpInto(arr2, out, SetOp::Intersection, strategy);
+}
+
+template <typename T>
+size_t Array<T>::Intersection(const Array<T> &arr2, std::span<T> out,
+                              SetStrategy strategy) const {
+  return SetOpInto(arr2, out, SetOp::Intersection, strategy);
+}
+
+template <typename T>
+template <std::output_iterator<const T &> OutputIt>
+size_t Array<T>::Intersection(const Array<T> &arr2, OutputIt out,
+                              SetStrategy strategy) const {
+  return SetOpToIterator(A, length, arr2.A, arr2.length, out,
+                         SetOp::Intersection, strategy);
+}
+
+template <typename T>
+size_t Array<T>::Difference(const Array<T> &arr2, Array<T> &out,
+                            SetStrategy strategy) const {
+  return SetOpInto(arr2, out, SetOp::Difference, strategy);
+}
+
+template <typename T>
+size_t Array<T>::Difference(const Array<T> &arr2, std::span<T> out,
+                            SetStrategy strategy) const {
+  return SetOpInto(arr2, out, SetOp::Difference, strategy);
+}
+
+template <typename T>
+template <std::output_iterator<const T &> OutputIt>
+size_t Array<T>::Difference(const Array<T> &arr2, OutputIt out,
+                            SetStrategy strategy) const {
+  return SetOpToIterator(A, length, arr2.A, arr2.length, out, SetOp::Difference,
+                         strategy);
+}
+
+// Merges sorted arr2 into this sorted array in place. After one Reserve the
+// merge runs from the back, so every element moves at most once and nothing
+// is overwritten before it has been read.
+template <typename T> void Array<T>::MergeWith(const Array<T> &arr2) {
+  if (&arr2 == this) {
+    Array<T> copy(arr2);
+    MergeWith(copy);
+    return;
+  }
+  Reserve(length + arr2.length);
+  size_t i = length, j = arr2.length, k = length + arr2.length;
+  while (j > 0) {
+    // Ties take arr2's element first here so it lands after ours, matching
+    // the order Merge() produces.
+    if (i > 0 && arr2.A[j - 1] < A[i - 1])
+      A[--k] = std::move(A[--i]);
+    else
+      A[--k] = arr2.A[--j];
+  }
+  length += arr2.length;
+}
+
+// --- Parallel set operations ---
+
+// Below this many input elements per thread, starting threads costs more
+// than it saves.
+inline constexpr size_t kParallelSetMinPart = size_t(1) << 16;
+
+// Walks back from the ends of a[0, na) and b[0, nb) one run of equal values
+// at a time, until the runs walked give at least `want` result elements or
+// the inputs run out. Returns where the walk stopped. No run is split, so
+// the result of the ranges before the stop followed by the result of the
+// ranges after it is the whole result.
+template <typename T>
+std::pair<size_t, size_t> Array<T>::SetOpTail(const T *a, size_t na,
+                                              const T *b, size_t nb,
+                                              SetOp op, size_t want) {
+  size_t i = na, j = nb, produced = 0;
+  while (produced < want && (i > 0 || j > 0)) {
+    const T &v =
+        (j == 0 || (i > 0 && b[j - 1] < a[i - 1])) ? a[i - 1] : b[j - 1];
+    size_t ca = 0, cb = 0;
+    for (; i > 0 && !(a[i - 1] < v); --i)
+      ++ca;
+    for (; j > 0 && !(b[j - 1] < v); --j)
+      ++cb;
+    switch (op) {
+    case SetOp::Merge:
+      produced += ca + cb;
+      break;
+    case SetOp::Union:
+      produced += std::max(ca, cb);
+      break;
+    case SetOp::Intersection:
+      produced += std::min(ca, cb);
+      break;
+    case SetOp::Difference:
+      produced += ca > cb ? ca - cb : 0;
+      break;
+    }
+  }
+  return {i, j};
+}
+
+// Cuts both inputs at evenly spaced merge-path diagonals so each thread gets
+// an equal share of the merge. Merge knows each slice's output offset up
+// front and writes in place. The other operations cannot know how much a
+// slice keeps until it runs, so a first parallel pass counts each slice
+// through the scalar cores without storing anything; an exclusive prefix sum
+// of the counts gives every slice its offset, and a second parallel pass
+// writes each slice straight into the result. No locks are needed.
+//
+// The vectorized kernels write past their result, which in the result array
+// is the start of the next slice. Only the last slice, which ends in the
+// result's own slack, runs them to the end. Every other slice runs them up to
+// the runs of equal values that give its last kSimdSetOutputSlack or more
+// elements, and finishes those with the Linear core, which overwrites the
+// overrun and writes nothing past the slice.
+template <typename T>
+Array<T> Array<T>::ParallelSetOp(const Array<T> &arr2, SetOp op,
+                                 size_t threads) const {
+  size_t total = length + arr2.length;
+  size_t parts =
+      std::min(resolve_thread_count(threads), total / kParallelSetMinPart);
+  if (parts <= 1) {
+    SetStrategy strategy =
+        op == SetOp::Merge ? SetStrategy::Linear : SetStrategy::Auto;
+    return SetOpToArray(arr2, op, strategy);
+  }
+
+  std::vector<std::pair<size_t, size_t>> cuts(parts + 1);
+  cuts[parts] = {length, arr2.length};
+  for (size_t p = 1; p < parts; ++p) {
+    size_t diag = total / parts * p;
+    cuts[p] = op == SetOp::Merge
+                  ? merge_path_split(A, length, arr2.A, arr2.length, diag)
+                  : merge_path_value_split(A, length, arr2.A, arr2.length,
+                                           diag);
+  }
+
+  if (op == SetOp::Merge) {
+    Array<T> result(total);
+    parallel_for(parts, [&](size_t p) {
+      auto [i0, j0] = cuts[p];
+      auto [i1, j1] = cuts[p + 1];
+      MergeCore(A + i0, i1 - i0, arr2.A + j0, j1 - j0, result.A + i0 + j0);
+    });
+    result.length = total;
+    return result;
+  }
+
+  std::vector<size_t> offsets(parts + 1, 0);
+  parallel_for(parts, [&](size_t p) {
+    auto [i0, j0] = cuts[p];
+    auto [i1, j1] = cuts[p + 1];
+    offsets[p + 1] =
+        SetOpToIterator(A + i0, i1 - i0, arr2.A + j0, j1 - j0,
+                        DiscardWriter<T>(), op, SetStrategy::Auto);
+  });
+  for (size_t p = 0; p < parts; ++p)
+    offsets[p + 1] += offsets[p];
+
+  Array<T> result(offsets[parts] + kSimdSetOutputSlack);
+  parallel_for(parts, [&](size_t p) {
+    auto [i0, j0] = cuts[p];
+    auto [i1, j1] = cuts[p + 1];
+    const T *a = A + i0, *b = arr2.A + j0;
+    size_t na = i1 - i0, nb = j1 - j0;
+    T *out = result.A + offsets[p];
+    if (p + 1 == parts) {
+      SetOpToBuffer(a, na, b, nb, out, op, SetStrategy::Auto);
+      return;
+    }
+    auto [ih, jh] = SetOpTail(a, na, b, nb, op, kSimdSetOutputSlack);
+    size_t head = SetOpToBuffer(a, ih, b, jh, out, op, SetStrategy::Auto);
+    SetOpToIterator(a + ih, na - ih, b + jh, nb - jh, out + head, op,
+                    SetStrategy::Linear);
+  });
+  result.length = offsets[parts];
+  return result;
+}
+
+template <typename T>
+Array<T> Array<T>::ParallelMerge(const Array<T> &arr2, size_t threads) const {
+  return ParallelSetOp(arr2, SetOp::Merge, threads);
+}
+
+template <typename T>
+Array<T> Array<T>::ParallelUnion(const Array<T> &arr2, size_t threads) const {
+  return ParallelSetOp(arr2, SetOp::Union, threads);
+}
+
+template <typename T>
+Array<T> Array<T>::ParallelIntersection(const Array<T> &arr2,
+                                        size_t threads) const {
+  return ParallelSetOp(arr2, SetOp::Intersection, threads);
+}
+
+template <typename T>
+Array<T> Array<T>::ParallelDifference(const Array<T> &arr2,
+                                      size_t threads) const {
+  return ParallelSetOp(arr2, SetOp::Difference, threads);
+}
+
+// --- K-way set operations ---
+// Chaining pairwise operations re-copies the growing result at every step,
+// O(k * N) for k inputs of N total elements. These make a single pass.
+
+template <typename T>
+Array<T> Array<T>::MergeAll(std::span<const Array<T>> arrays) {
+  if (arrays.size() == 1)
+    return arrays[0];
+  if (arrays.size() == 2)
+    return arrays[0].Merge(arrays[1]);
+  std::vector<typename LoserTree<T>::Range> sources;
+  size_t total = 0;
+  for (const Array<T> &arr : arrays) {
+    sources.push_back({arr.A, arr.A + arr.length});
+    total += arr.length;
+  }
+  Array<T> result(total);
+  LoserTree<T> tree(sources);
+  for (; !tree.Empty(); tree.Pop())
+    result.A[result.length++] = tree.Top();
+  return result;
+}
+
+// Like chained Union: a value appearing c_i times in input i appears
+// max(c_i) times in the result.
+template <typename T>
+Array<T> Array<T>::UnionAll(std::span<const Array<T>> arrays) {
+  if (arrays.size() == 1)
+    return arrays[0];
+  if (arrays.size() == 2)
+    return arrays[0].Union(arrays[1]);
+  std::vector<typename LoserTree<T>::Range> sources;
+  size_t total = 0;
+  for (const Array<T> &arr : arrays) {
+    sources.push_back({arr.A, arr.A + arr.length});
+    total += arr.length;
+  }
+  Array<T> result(total);
+  LoserTree<T> tree(sources);
+  while (!tree.Empty()) {
+    // Equal values leave the tree grouped by source, lowest index first,
+    // because ties go to the lower index.
+    const T *value = tree.TopPointer();
+    size_t copies = 0;
+    while (!tree.Empty() && !(*value < tree.Top())) {
+      size_t source = tree.TopSource(), run = 0;
+      while (!tree.Empty() && tree.TopSource() == source &&
+             !(*value < tree.Top())) {
+        tree.Pop();
+        ++run;
+      }
+      copies = std::max(copies, run);
+    }
+    for (size_t c = 0; c < copies; ++c)
+      result.A[result.length++] = *value;
+  }
+  return result;
+}
+
+// Like chained Intersection: a value appearing c_i times in input i appears
+// min(c_i) times, taken from arrays[0]. Candidates come from the smallest
+// input; the others are probed shortest first with galloping search, and a
+// miss skips the candidate list ahead to the value that was found instead.
+template <typename T>
+Array<T> Array<T>::IntersectAll(std::span<const Array<T>> arrays) {
+  if (arrays.empty())
+    return Array<T>();
+  if (arrays.size() == 1)
+    return arrays[0];
+  if (arrays.size() == 2)
+    return arrays[0].Intersection(arrays[1]);
+  std::vector<size_t> order(arrays.size());
+  for (size_t i = 0; i < order.size(); ++i)
+    order[i] = i;
+  std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    return arrays[a].length < arrays[b].length;
+  });
+  const Array<T> &smallest = arrays[order[0]];
+  Array<T> result(smallest.length);
+  std::vector<size_t> pos(arrays.size(), 0);
+  size_t s = 0;
+  while (s < smallest.length) {
+    const T *candidate = smallest.A + s;
+    size_t copies = 1;
+    while (s + copies < smallest.length &&
+           !(*candidate < smallest.A[s + copies]))
+      ++copies;
+    pos[order[0]] = s;
+    bool matched = true;
+    for (size_t r = 1; r < order.size(); ++r) {
+      const Array<T> &list = arrays[order[r]];
+      size_t &p = pos[order[r]];
+      p = gallop_lower_bound(list.A, p, list.length, *candidate);
+      if (p == list.length)
+        return result;
+      if (*candidate < list.A[p]) {
+        s = gallop_lower_bound(smallest.A, s + copies, smallest.length,
+                               list.A[p]);
+        matched = false;
+        break;
+      }
+      size_t run = 1;
+      while (run < copies && p + run < list.length &&
+             !(*candidate < list.A[p + run]))
+        ++run;
+      copies = run;
+    }
+    if (!matched)
+      continue;
+    for (size_t c = 0; c < copies; ++c)
+      result.A[result.length++] = arrays[0].A[pos[0] + c];
+    while (s < smallest.length && !(*candidate < smallest.A[s]))
+      ++s;
+  }
+  return result;
+}
+
+template <typename T>
+template <ResultSink<DuplicateRun<T>> Sink>
+void Array<T>::FindDuplicatesHashing(Sink &&sink) const {
   if (length < 2)
     return;
-  std::unordered_map<T, int> freq_map;
+  // No count can pass the length, so 4-byte counts do unless the array is
+  // longer than that. They halve the slot of an int key, and the table is
+  // sized for every element being distinct.
+  if (length <= UINT32_MAX)
+    CountDuplicatesHashing<uint32_t>(sink);
+  else
+    CountDuplicatesHashing<size_t>(sink);
+}
+
+template <typename T>
+template <typename Count, typename Sink>
+void Array<T>::CountDuplicatesHashing(Sink &sink) const {
+  FlatHashMap<T, Count> freq_map(length);
   for (size_t i = 0; i < length; ++i) {
     freq_map[A[i]]++;
   }
-  std::cout << "--- Duplicates Found (Hashing) ---" << std::endl;
-  bool found = false;
-  for (const auto &entry : freq_map) {
-    if (entry.second > 1) {
-      std::cout << "Value: " << entry.first << ", Occurrences: "
-                << entry.second << std::endl;
-      found = true;
+  // A second pass reports each duplicate at its first occurrence, so the
+  // order does not depend on the hash table. Zeroing the count marks it done.
+  for (size_t i = 0; i < length; ++i) {
+    Count &count = *freq_map.Find(A[i]);
+    if (count > 1) {
+      DuplicateRun<T> run{A[i], count};
+      count = 0;
+      if (!invoke_sink(sink, run))
+        return;
     }
   }
-  if (!found)
-    std::cout << "No duplicates found." << std::endl;
+}
+
+// Values per hash partition: a table for this many keys fits in L2.
+inline constexpr size_t kCountPartitionSize = size_t(1) << 16;
+
+template <typename T>
+std::vector<DuplicateRun<T>>
+Array<T>::ParallelCount(size_t min_count, size_t threads) const {
+  // Partition on hash bits 45..56. The tables index by the low bits and tag
+  // by the top 7, which would otherwise be the same across a partition.
+  auto hash = [](const T &v) {
+    return flat_hash_detail::Mix(std::hash<T>{}(v)) << 7;
+  };
+  unsigned bits = hash_partition_bits(length, kCountPartitionSize);
+  std::unique_ptr<T[]> grouped = std::make_unique_for_overwrite<T[]>(length);
+  std::vector<size_t> bounds =
+      hash_partition(A, length, bits, hash, grouped.get(), threads);
+
+  // Workers claim partitions one at a time, so a large partition does not
+  // hold up the rest. Each reuses one table across its partitions.
+  const size_t parts = bounds.size() - 1;
+  std::vector<std::vector<DuplicateRun<T>>> found(parts);
+  std::atomic<size_t> next_part{0};
+  parallel_for(std::min(resolve_thread_count(threads), parts), [&](size_t) {
+    FlatHashMap<T, size_t> counts;
+    for (size_t p; (p = next_part.fetch_add(1)) < parts;) {
+      const T *first = grouped.get() + bounds[p];
+      const T *last = grouped.get() + bounds[p + 1];
+      counts.Clear();
+      // Clear costs the table's capacity, so a partition swollen by one hot
+      // value must not size the table that every later partition clears.
+      // A partition with more distinct values than this grows by rehashing.
+      counts.Reserve(std::min<size_t>(last - first, 2 * kCountPartitionSize));
+      for (const T *v = first; v != last; ++v)
+        ++counts[*v];
+      // As in FindDuplicatesHashing, zeroing a count marks it reported.
+      for (const T *v = first; v != last; ++v) {
+        size_t &count = *counts.Find(*v);
+        if (count >= min_count)
+          found[p].push_back({*v, count});
+        count = 0;
+      }
+    }
+  });
+
+  size_t total = 0;
+  for (const auto &runs : found)
+    total += runs.size();
+  std::vector<DuplicateRun<T>> result;
+  result.reserve(total);
+  for (const auto &runs : found)
+    result.insert(result.end(), runs.begin(), runs.end());
+  return result;
+}
+
+template <typename T>
+std::vector<DuplicateRun<T>>
+Array<T>::ParallelFindDuplicates(size_t threads) const {
+  return ParallelCount(2, threads);
+}
+
+template <typename T>
+std::vector<DuplicateRun<T>>
+Array<T>::ParallelCountFrequencies(size_t threads) const {
+  return ParallelCount(1, threads);
 }
 
 template <typename T>
@@ -513,11 +1840,12 @@ std::optional<std::pair<T, T>> Array<T>::PairWithSum_Sorted(const T &k) const {
 
   // Two-pointer scan: sorted order lets us move inward based on the sum.
   size_t low = 0, high = length - 1;
+  const PairSum<T> target = k;
   while (low < high) {
-    T current_sum = A[low] + A[high];
-    if (current_sum == k)
+    PairSum<T> current_sum = PairSum<T>(A[low]) + PairSum<T>(A[high]);
+    if (current_sum == target)
       return std::make_pair(A[low], A[high]);
-    else if (current_sum < k)
+    else if (current_sum < target)
       low++;
     else
       high--;
@@ -527,13 +1855,13 @@ std::optional<std::pair<T, T>> Array<T>::PairWithSum_Sorted(const T &k) const {
 
 template <typename T>
 std::optional<std::pair<T, T>> Array<T>::PairWithSum_Hashing(const T &k) const {
-  std::unordered_set<T> seen_elements;
+  FlatHashSet<T> seen_elements(length);
   for (size_t i = 0; i < length; ++i) {
-    T complement = k - A[i];
-    if (seen_elements.count(complement)) {
-      return std::make_pair(complement, A[i]);
+    std::optional<T> complement = PairComplement(k, A[i]);
+    if (complement && seen_elements.Contains(*complement)) {
+      return std::make_pair(*complement, A[i]);
     }
-    seen_elements.insert(A[i]);
+    seen_elements.Insert(A[i]);
   }
   return std::nullopt;
 }
@@ -545,6 +1873,29 @@ std::optional<std::pair<T, T>> Array<T>::FindMinMax() const {
   if (length == 1)
     return std::make_pair(A[0], A[0]);
 
+  if constexpr (std::is_arithmetic_v<T>) {
+    // Independent per-lane reductions compile to branch-free (and, with
+    // SIMD, vectorized) min/max. The paired scan below saves comparisons,
+    // but its branches mispredict on unordered data.
+    constexpr size_t kLanes = 8;
+    T lo[kLanes], hi[kLanes];
+    std::fill(lo, lo + kLanes, A[0]);
+    std::fill(hi, hi + kLanes, A[0]);
+    size_t i = 0;
+    for (; i + kLanes <= length; i += kLanes) {
+      for (size_t l = 0; l < kLanes; ++l) {
+        lo[l] = A[i + l] < lo[l] ? A[i + l] : lo[l];
+        hi[l] = hi[l] < A[i + l] ? A[i + l] : hi[l];
+      }
+    }
+    for (; i < length; ++i) {
+      lo[0] = A[i] < lo[0] ? A[i] : lo[0];
+      hi[0] = hi[0] < A[i] ? A[i] : hi[0];
+    }
+    return std::make_pair(*std::min_element(lo, lo + kLanes),
+                          *std::max_element(hi, hi + kLanes));
+  }
+
   T min_val, max_val;
   size_t start_index;
 
@@ -579,33 +1930,18 @@ std::optional<std::pair<T, T>> Array<T>::FindMinMax() const {
   return std::make_pair(min_val, max_val);
 }
 
-template <typename T> void Array<T>::FindDuplicatesSorted() const {
-  if (length < 2) {
-    std::cout << "No duplicates found in this sorted array." << std::endl;
-    return;
-  }
-
-  bool found = false;
-  for (size_t i = 0; i < length - 1;) {
-    if (A[i] == A[i + 1]) {
-      found = true;
-      size_t count =
-          2; // We already have two identical elements: A[i] and A[i+1]
-      size_t j = i + 2;
-
-      while (j < length && A[j] == A[i]) {
-        ++count;
-        j++;
-      }
-      std::cout << "Duplicate value: " << A[i] << "\nOccurrences: " << count
-                << " times." << std::endl;
-      i = j; // skip ahead to the next distinct element
-    } else {
-      ++i;
-    }
-  }
-  if (!found) {
-    std::cout << "No duplicates found in this sorted array." << std::endl;
+// Requires SORTED Array
+template <typename T>
+template <ResultSink<DuplicateRun<T>> Sink>
+void Array<T>::FindDuplicatesSorted(Sink &&sink) const {
+  for (size_t i = 0; i < length;) {
+    size_t j = i + 1;
+    while (j < length && A[j] == A[i])
+      ++j;
+    // A[i..j) is one run of equal values; skip ahead to the next one.
+    if (j - i > 1 && !invoke_sink(sink, DuplicateRun<T>{A[i], j - i}))
+      return;
+    i = j;
   }
 }
 
@@ -624,29 +1960,18 @@ std::optional<T> Array<T>::FindSingleMissingElementSorted() const {
   return std::nullopt;
 }
 
-template <typename T> void Array<T>::FindMultipleMissingElementsSorted() const {
-  if (length == 0) {
-    std::cout << "Array is empty." << std::endl;
-    return;
-  }
-  T expected_diff = A[0] - 0;
-  bool found_missing = false;
-  std::cout << "Missing elements (Sorted Method): ";
-  for (size_t index = 0; index < length; index++) {
-    T i = static_cast<T>(index);
-    if (A[index] - i != expected_diff) {
-      // A larger-than-expected value means all values in the gap are missing.
-      while (expected_diff < A[index] - i) {
-        std::cout << (i + expected_diff) << " ";
-        expected_diff++;
-        found_missing = true;
-      }
-    }
-  }
-  if (!found_missing) {
-    std::cout << "None found in sequence.";
+// Requires SORTED Array
+template <typename T>
+template <ResultSink<MissingRange<T>> Sink>
+void Array<T>::FindMultipleMissingElementsSorted(Sink &&sink) const {
+  // Each gap between neighbouring values is one range; repeated values just
+  // leave no gap. Checking prev < cur first keeps prev + 1 from overflowing.
+  for (size_t i = 1; i < length; ++i) {
+    const T &prev = A[i - 1], &cur = A[i];
+    if (prev < cur && prev + 1 < cur &&
+        !invoke_sink(sink, MissingRange<T>{static_cast<T>(prev + 1), cur}))
+      return;
   }
-  std::cout << std::endl;
 }
 
 // Works on UNSORTED array using XOR.
@@ -663,87 +1988,428 @@ std::optional<T> Array<T>::FindSingleMissingElementUnsortedOptimal() const {
     return std::nullopt;
   }
 
-  T xor_sum_array = 0;
-  T xor_sum_expected = 0;
-
   // XOR cancels equal values. Remaining bits identify the missing value when
-  // the data represents one complete range with exactly one gap.
-  for (size_t i = 0; i < length; i++) {
-    xor_sum_array ^= A[i];
-  }
-
-  // 2. XOR sum of expected sequence (min_val to min_val + length)
-  long long max_expected_11 = static_cast<long long>(min_val) + length;
-  if (max_expected_11 > std::numeric_limits<T>::max() ||
-      max_expected_11 < std::numeric_limits<T>::min()) {
+  // the data represents one complete range with exactly one gap. Values are
+  // XORed as unsigned offsets from the minimum, so the expected side is the
+  // closed-form XOR of 0..length rather than a walk over the range.
+  using U = std::make_unsigned_t<T>;
+  const U base = static_cast<U>(min_val);
+  if (static_cast<U>(static_cast<U>(std::numeric_limits<T>::max()) - base) <
+      length) {
     std::cerr << "Warning: Expected range for XOR calculations might exceed "
                  "integer limits."
               << std::endl;
   }
-  T max_expected = static_cast<T>(max_expected_11);
-
-  for (T current_expected = min_val; current_expected <= max_expected;
-       ++current_expected) {
-    xor_sum_expected ^= current_expected;
-    if (current_expected == std::numeric_limits<T>::max() &&
-        current_expected < max_expected)
-      break;
-  }
+  uint64_t xor_offsets = 0;
+  for (size_t i = 0; i < length; i++)
+    xor_offsets ^= static_cast<U>(static_cast<U>(A[i]) - base);
+  xor_offsets ^= xor_upto(length);
 
-  T missing_element = xor_sum_array ^ xor_sum_expected;
   // Basic validation removed for optional return - caller decides if value is
   // valid
-  return missing_element;
+  return static_cast<T>(static_cast<U>(base + static_cast<U>(xor_offsets)));
 }
 
-// Works on UNSORTED array using hashing (simple boolean array).
-template <typename T> void Array<T>::FindMultipleMissingElementsHash() const {
-  if (length == 0) {
-    std::cout << "Array is empty." << std::endl;
+// Works on UNSORTED array using hashing (a presence bitmap over the range).
+template <typename T>
+template <ResultSink<MissingRange<T>> Sink>
+void Array<T>::FindMultipleMissingElementsHash(Sink &&sink,
+                                               size_t threads) const {
+  static_assert(std::is_integral_v<T>,
+                "FindMultipleMissingElementsHash requires an integer type.");
+  auto min_max = FindMinMax();
+  if (!min_max)
     return;
+  // Offsets are taken in the unsigned type, where max - min cannot overflow.
+  using U = std::make_unsigned_t<T>;
+  const U base = static_cast<U>(min_max->first);
+  const uint64_t span = static_cast<U>(static_cast<U>(min_max->second) - base);
+  auto value_at = [base](uint64_t offset) {
+    return static_cast<T>(static_cast<U>(base + offset));
+  };
+
+  // The range [0, span] is covered in windows of at most kPresenceChunkBits.
+  // A gap can cross a window boundary, so each run is held back until the
+  // next one shows it has ended.
+  std::vector<uint64_t> words(
+      presence_words(std::min(span, kPresenceChunkBits - 1) + 1));
+  std::optional<MissingRange<T>> pending;
+  for (uint64_t start = 0;; start += kPresenceChunkBits) {
+    const uint64_t rest = span - start; // bits left in the range, minus one
+    const uint64_t bits =
+        rest >= kPresenceChunkBits - 1 ? kPresenceChunkBits : rest + 1;
+    std::fill(words.begin(), words.begin() + presence_words(bits), 0);
+    mark_present_parallel(A, length, static_cast<U>(base + start), bits,
+                          words.data(), threads);
+    bool go_on = for_each_clear_run(
+        words.data(), bits, [&](uint64_t lo, uint64_t hi) {
+          MissingRange<T> gap{value_at(start + lo), value_at(start + hi)};
+          if (pending && pending->hi == gap.lo) {
+            pending->hi = gap.hi;
+            return true;
+          }
+          bool keep = !pending || invoke_sink(sink, *pending);
+          pending = gap;
+          return keep;
+        });
+    if (!go_on)
+      return;
+    if (rest < kPresenceChunkBits)
+      break;
   }
-  T min_val = Min();
-  T max_val = Max();
+  // The maximum is always present, so the last gap is already closed.
+  if (pending)
+    invoke_sink(sink, *pending);
+}
 
-  if (min_val == max_val && length > 0) {
-    std::cout << "Array contains only one distinct value or is empty. No gaps "
-                 "possible within the range."
-              << std::endl;
-    return;
+template <typename T>
+std::vector<MissingRange<T>>
+Array<T>::FindMultipleMissingElementsSorted() const {
+  return CollectToVector<MissingRange<T>>(
+      [this](auto &sink) { FindMultipleMissingElementsSorted(sink); });
+}
+
+template <typename T>
+size_t Array<T>::FindMultipleMissingElementsSorted(
+    std::span<MissingRange<T>> out) const {
+  return CollectToSpan(
+      out, [this](auto &sink) { FindMultipleMissingElementsSorted(sink); });
+}
+
+template <typename T>
+std::vector<MissingRange<T>>
+Array<T>::FindMultipleMissingElementsHash(size_t threads) const {
+  return CollectToVector<MissingRange<T>>([this, threads](auto &sink) {
+    FindMultipleMissingElementsHash(sink, threads);
+  });
+}
+
+template <typename T>
+size_t
+Array<T>::FindMultipleMissingElementsHash(std::span<MissingRange<T>> out,
+                                          size_t threads) const {
+  return CollectToSpan(out, [this, threads](auto &sink) {
+    FindMultipleMissingElementsHash(sink, threads);
+  });
+}
+
+template <typename T>
+std::vector<DuplicateRun<T>> Array<T>::FindDuplicatesSorted() const {
+  return CollectToVector<DuplicateRun<T>>(
+      [this](auto &sink) { FindDuplicatesSorted(sink); });
+}
+
+template <typename T>
+size_t Array<T>::FindDuplicatesSorted(std::span<DuplicateRun<T>> out) const {
+  return CollectToSpan(out,
+                       [this](auto &sink) { FindDuplicatesSorted(sink); });
+}
+
+template <typename T>
+std::vector<DuplicateRun<T>> Array<T>::FindDuplicatesHashing() const {
+  return CollectToVector<DuplicateRun<T>>(
+      [this](auto &sink) { FindDuplicatesHashing(sink); });
+}
+
+template <typename T>
+size_t Array<T>::FindDuplicatesHashing(std::span<DuplicateRun<T>> out) const {
+  return CollectToSpan(out,
+                       [this](auto &sink) { FindDuplicatesHashing(sink); });
+}
+
+// --- Query Dispatch ---
+
+// Arrays up to this long are cheaper to compare pairwise than to hash.
+inline constexpr size_t kBruteForceMaxLength = 32;
+// FindDuplicates counts in a table indexed by value when the range is at
+// most this many times the length: 4-byte counters then take no more room
+// than a hash table, and need no probing.
+inline constexpr uint64_t kDirectCountRangeFactor = 4;
+// PairWithSum marks a bitmap of up to this many bits per element.
+inline constexpr uint64_t kDirectPairRangeFactor = 256;
+// FindMissing marks a bitmap while clearing and scanning it costs less than
+// sorting a copy: up to this many bits per element per comparison the sort
+// would make, about log2(n) each.
+inline constexpr uint64_t kDirectMissingBitsPerCompare = 32;
+// Largest count table or bitmap built directly, even when forced. 2^28
+// counters take 1 GiB.
+inline constexpr uint64_t kDirectAddressMaxRange = uint64_t(1) << 28;
+// FindMissing marks its bitmap in windows of kPresenceChunkBits, and each
+// window reads the whole array again, so the range is capped at 64 windows.
+inline constexpr uint64_t kDirectMissingMaxRange = 64 * kPresenceChunkBits;
+// From this length, ParallelHashing repays its partitioning pass even on one
+// thread, because each partition's table stays in cache.
+inline constexpr size_t kParallelHashingMinLength = size_t(1) << 20;
+
+// Integer types other than bool can be used as a table index.
+template <typename T>
+inline constexpr bool kDirectAddressable =
+    std::is_integral_v<T> && !std::is_same_v<T, bool>;
+
+template <typename T>
+typename Array<T>::QueryStats Array<T>::GatherQueryStats() const {
+  QueryStats stats;
+  stats.sorted = isSorted();
+  if constexpr (kDirectAddressable<T>) {
+    if (length == 0)
+      return stats;
+    T lo = A[0], hi = A[length - 1];
+    if (!stats.sorted)
+      std::tie(lo, hi) = *FindMinMax();
+    // max - min is taken in the unsigned type, where it cannot overflow.
+    using U = std::make_unsigned_t<T>;
+    uint64_t span = static_cast<U>(static_cast<U>(hi) - static_cast<U>(lo));
+    stats.min = lo;
+    stats.range = span == UINT64_MAX ? span : span + 1;
   }
+  return stats;
+}
 
-  // create a boolean hash set for the range [min_val, max_val]
-  T range_size = max_val - min_val + 1;
-  if (range_size <= 0) {
-    std::cerr << "Error: Invalid range calculated (max <= min)." << std::endl;
-    return;
+template <typename T>
+QueryPlan Array<T>::ResolveDuplicatesPlan(QueryPlan plan,
+                                          const QueryStats &stats) const {
+  const bool direct = kDirectAddressable<T> &&
+                      stats.range <= kDirectAddressMaxRange &&
+                      length <= UINT32_MAX;
+  if (plan == QueryPlan::Auto) {
+    if (length <= kBruteForceMaxLength)
+      return QueryPlan::BruteForce;
+    if (stats.sorted)
+      return QueryPlan::SortedScan;
+    if (direct && stats.range <= kDirectCountRangeFactor * length)
+      return QueryPlan::DirectAddress;
+    if (length >= kParallelHashingMinLength)
+      return QueryPlan::ParallelHashing;
+    return QueryPlan::Hashing;
   }
-  // Boolean hashing maps each possible value in the min..max range to a slot.
-  std::vector<bool> hash_set(static_cast<size_t>(range_size), false);
+  if (plan == QueryPlan::SortedCopy ||
+      (plan == QueryPlan::SortedScan && !stats.sorted) ||
+      (plan == QueryPlan::DirectAddress && !direct))
+    throw std::invalid_argument(std::string("FindDuplicates cannot use ") +
+                                QueryPlanName(plan));
+  return plan;
+}
 
-  // mark elements present in the array
-  for (size_t i = 0; i < length; i++) {
-    // check if element is within the calculated range before hashing
-    if (A[i] >= min_val && A[i] <= max_val) {
-      hash_set[static_cast<size_t>(A[i] - min_val)] = true;
-    }
+template <typename T>
+QueryPlan Array<T>::ResolveMissingPlan(QueryPlan plan,
+                                       const QueryStats &stats) const {
+  const bool direct = stats.range <= kDirectMissingMaxRange;
+  if (plan == QueryPlan::Auto) {
+    if (stats.sorted)
+      return QueryPlan::SortedScan;
+    if (direct &&
+        stats.range / kDirectMissingBitsPerCompare / std::bit_width(length) <=
+            length)
+      return QueryPlan::DirectAddress;
+    return QueryPlan::SortedCopy;
+  }
+  if ((plan != QueryPlan::SortedScan && plan != QueryPlan::DirectAddress &&
+       plan != QueryPlan::SortedCopy) ||
+      (plan == QueryPlan::SortedScan && !stats.sorted) ||
+      (plan == QueryPlan::DirectAddress && !direct))
+    throw std::invalid_argument(std::string("FindMissing cannot use ") +
+                                QueryPlanName(plan));
+  return plan;
+}
+
+template <typename T>
+QueryPlan Array<T>::ResolvePairSumPlan(QueryPlan plan,
+                                       const QueryStats &stats) const {
+  const bool direct =
+      kDirectAddressable<T> && stats.range <= kDirectAddressMaxRange;
+  if (plan == QueryPlan::Auto) {
+    if (length <= kBruteForceMaxLength)
+      return QueryPlan::BruteForce;
+    if (stats.sorted)
+      return QueryPlan::SortedScan;
+    if (direct && stats.range <= kDirectPairRangeFactor * length)
+      return QueryPlan::DirectAddress;
+    return QueryPlan::Hashing;
   }
+  if (plan == QueryPlan::ParallelHashing || plan == QueryPlan::SortedCopy ||
+      (plan == QueryPlan::SortedScan && !stats.sorted) ||
+      (plan == QueryPlan::DirectAddress && !direct))
+    throw std::invalid_argument(std::string("PairWithSum cannot use ") +
+                                QueryPlanName(plan));
+  return plan;
+}
+
+template <typename T> QueryPlan Array<T>::PlanFindDuplicates() const {
+  return ResolveDuplicatesPlan(QueryPlan::Auto, GatherQueryStats());
+}
 
-  // Iterate through the hash set range and print unmarked elements
-  bool found_missing = false;
-  std::cout << "Missing elements (Hash method, range[" << min_val << ", "
-            << max_val << "]}: ";
-  for (T i = 0; i < range_size; i++) {
-    if (!hash_set[static_cast<size_t>(i)]) {
-      std::cout << (i + min_val) << " "; // Missing number = Index + MinValue
-      found_missing = true;
+template <typename T> QueryPlan Array<T>::PlanFindMissing() const {
+  return ResolveMissingPlan(QueryPlan::Auto, GatherQueryStats());
+}
+
+template <typename T> QueryPlan Array<T>::PlanPairWithSum() const {
+  return ResolvePairSumPlan(QueryPlan::Auto, GatherQueryStats());
+}
+
+template <typename T>
+template <ResultSink<DuplicateRun<T>> Sink>
+void Array<T>::FindDuplicates(Sink &&sink, QueryPlan plan) const {
+  QueryStats stats;
+  if (NeedsQueryStats(plan))
+    stats = GatherQueryStats();
+  plan = ResolveDuplicatesPlan(plan, stats);
+
+  if (plan == QueryPlan::SortedScan) {
+    FindDuplicatesSorted(sink);
+    return;
+  }
+  std::vector<DuplicateRun<T>> runs;
+  if (plan == QueryPlan::DirectAddress) {
+    if constexpr (kDirectAddressable<T>) {
+      using U = std::make_unsigned_t<T>;
+      const U base = static_cast<U>(stats.min);
+      std::vector<uint32_t> counts(static_cast<size_t>(stats.range), 0);
+      for (size_t i = 0; i < length; ++i)
+        ++counts[static_cast<U>(static_cast<U>(A[i]) - base)];
+      for (size_t offset = 0; offset < counts.size(); ++offset)
+        if (counts[offset] > 1 &&
+            !invoke_sink(sink,
+                         DuplicateRun<T>{static_cast<T>(static_cast<U>(
+                                             base + offset)),
+                                         counts[offset]}))
+          return;
     }
+    return;
   }
-  if (!found_missing) {
-    std::cout << "None found in range.";
+  if (plan == QueryPlan::BruteForce) {
+    for (size_t i = 0; i < length; ++i) {
+      size_t j = 0;
+      while (j < i && !(A[j] == A[i]))
+        ++j;
+      if (j < i)
+        continue; // counted at its first occurrence
+      size_t count = 1;
+      for (j = i + 1; j < length; ++j)
+        count += A[j] == A[i];
+      if (count > 1)
+        runs.push_back({A[i], count});
+    }
+  } else if (plan == QueryPlan::ParallelHashing) {
+    runs = ParallelFindDuplicates(0);
+  } else {
+    runs = FindDuplicatesHashing();
   }
-  std::cout << std::endl;
-  // vector cleans itself up automatically (RAII)
+  std::sort(runs.begin(), runs.end(),
+            [](const DuplicateRun<T> &a, const DuplicateRun<T> &b) {
+              return a.value < b.value;
+            });
+  for (const DuplicateRun<T> &run : runs)
+    if (!invoke_sink(sink, run))
+      return;
+}
+
+template <typename T>
+std::vector<DuplicateRun<T>> Array<T>::FindDuplicates(QueryPlan plan) const {
+  return CollectToVector<DuplicateRun<T>>(
+      [&](auto &sink) { FindDuplicates(sink, plan); });
+}
+
+template <typename T>
+size_t Array<T>::FindDuplicates(std::span<DuplicateRun<T>> out,
+                                QueryPlan plan) const {
+  return CollectToSpan(out, [&](auto &sink) { FindDuplicates(sink, plan); });
+}
+
+template <typename T>
+template <ResultSink<MissingRange<T>> Sink>
+void Array<T>::FindMissing(Sink &&sink, QueryPlan plan) const {
+  static_assert(kDirectAddressable<T>, "FindMissing requires an integer type.");
+  QueryStats stats;
+  if (NeedsQueryStats(plan))
+    stats = GatherQueryStats();
+  switch (ResolveMissingPlan(plan, stats)) {
+  case QueryPlan::SortedScan:
+    FindMultipleMissingElementsSorted(sink);
+    break;
+  case QueryPlan::DirectAddress:
+    FindMultipleMissingElementsHash(sink, 0);
+    break;
+  default: {
+    Array<T> sorted(*this);
+    sorted.Sort();
+    sorted.FindMultipleMissingElementsSorted(sink);
+  }
+  }
+}
+
+template <typename T>
+std::vector<MissingRange<T>> Array<T>::FindMissing(QueryPlan plan) const {
+  return CollectToVector<MissingRange<T>>(
+      [&](auto &sink) { FindMissing(sink, plan); });
+}
+
+template <typename T>
+size_t Array<T>::FindMissing(std::span<MissingRange<T>> out,
+                             QueryPlan plan) const {
+  return CollectToSpan(out, [&](auto &sink) { FindMissing(sink, plan); });
+}
+
+template <typename T>
+std::optional<std::pair<T, T>> Array<T>::PairWithSum(const T &k,
+                                                     QueryPlan plan) const {
+  QueryStats stats;
+  if (NeedsQueryStats(plan))
+    stats = GatherQueryStats();
+  switch (ResolvePairSumPlan(plan, stats)) {
+  case QueryPlan::BruteForce:
+    // Same pair as the hashing scan: the first element that completes one.
+    for (size_t j = 1; j < length; ++j)
+      for (size_t i = 0; i < j; ++i)
+        if (PairSum<T>(A[i]) + PairSum<T>(A[j]) == PairSum<T>(k))
+          return std::make_pair(A[i], A[j]);
+    return std::nullopt;
+  case QueryPlan::SortedScan:
+    return PairWithSum_Sorted(k);
+  case QueryPlan::DirectAddress:
+    if constexpr (kDirectAddressable<T>) {
+      // The hashing scan with a bitmap of the values seen so far.
+      using U = std::make_unsigned_t<T>;
+      const U base = static_cast<U>(stats.min);
+      std::vector<uint64_t> seen(presence_words(stats.range), 0);
+      for (size_t i = 0; i < length; ++i) {
+        if (std::optional<T> complement = PairComplement(k, A[i])) {
+          uint64_t want = static_cast<U>(static_cast<U>(*complement) - base);
+          if (want < stats.range && (seen[want >> 6] >> (want & 63) & 1))
+            return std::make_pair(*complement, A[i]);
+        }
+        uint64_t offset = static_cast<U>(static_cast<U>(A[i]) - base);
+        seen[offset >> 6] |= uint64_t(1) << (offset & 63);
+      }
+    }
+    return std::nullopt;
+  default:
+    return PairWithSum_Hashing(k);
+  }
+}
+
+// --- Result Sink Helpers ---
+
+// `find` runs one of the sink-based finders with the sink it is given.
+template <typename T>
+template <typename R, typename Find>
+std::vector<R> Array<T>::CollectToVector(Find find) {
+  std::vector<R> results;
+  auto sink = [&results](const R &result) { results.push_back(result); };
+  find(sink);
+  return results;
+}
+
+template <typename T>
+template <typename R, typename Find>
+size_t Array<T>::CollectToSpan(std::span<R> out, Find find) {
+  SpanWriter<R> writer(out);
+  size_t count = 0;
+  auto sink = [&](const R &result) {
+    *writer++ = result;
+    ++count;
+  };
+  find(sink);
+  return count;
 }
 
 #endif // ARRAY_H
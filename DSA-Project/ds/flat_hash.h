@@ -0,0 +1,291 @@
+//
+//  flat_hash.h
+//  DSA-Project
+//
+//  Created by richie on 10/19/26.
+//
+
+#ifndef FLAT_HASH_H
+#define FLAT_HASH_H
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+
+// Open-addressing hash map and set with linear probing. Entries live in one
+// flat slot array instead of one heap node each, so building a table costs
+// two allocations whatever its size, and a probe walks adjacent memory
+// instead of chasing pointers.
+//
+// Each slot has a control byte: 0 for empty, otherwise the top 7 bits of the
+// hash with the high bit set. A probe compares keys only when the control
+// byte matches, and stops at the first empty slot. The control bytes live in
+// their own array, so slots pack without padding: an int key with a 4-byte
+// value takes 8 bytes plus its control byte, where a byte inside the slot
+// would round it up to 12 (16 with an 8-byte value).
+// Capacity is a power of two, kept at most 3/4 full; pass the expected
+// number of keys to the constructor to size the table once up front.
+//
+// Keys and values must be default-constructible. Erase shifts later entries
+// of the probe run back into the freed slot instead of leaving a tombstone,
+// so lookups never slow down after many erases.
+
+namespace flat_hash_detail {
+
+// Finalizer from MurmurHash3. std::hash is the identity for integers, and
+// masking an identity hash would index by the low bits alone; this spreads
+// every input bit across the word first.
+inline uint64_t Mix(uint64_t h) {
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdULL;
+  h ^= h >> 33;
+  h *= 0xc4ceb9fe1a85ec53ULL;
+  h ^= h >> 33;
+  return h;
+}
+
+template <typename K, typename V> struct MapSlot {
+  K key;
+  V value;
+};
+
+template <typename K> struct SetSlot {
+  K key;
+};
+
+// The probing core shared by FlatHashMap and FlatHashSet.
+template <typename Slot, typename Hash> class Table {
+public:
+  using Key = decltype(Slot::key);
+  static constexpr size_t kNotFound = static_cast<size_t>(-1);
+
+  explicit Table(size_t expected) { Allocate(CapacityFor(expected)); }
+
+  size_t Size() const { return size; }
+  size_t Capacity() const { return mask + 1; }
+
+  void Reserve(size_t expected) {
+    size_t capacity = CapacityFor(expected);
+    if (capacity > Capacity())
+      Rehash(capacity);
+  }
+
+  void Clear() {
+    std::fill(ctrl.get(), ctrl.get() + Capacity(), kEmpty);
+    size = 0;
+  }
+
+  // Index of the slot holding `key`, or kNotFound.
+  size_t Find(const Key &key) const {
+    uint64_t h = HashOf(key);
+    uint8_t tag = TagOf(h);
+    for (size_t i = h & mask;; i = (i + 1) & mask) {
+      if (ctrl[i] == kEmpty)
+        return kNotFound;
+      if (ctrl[i] == tag && slots[i].key == key)
+        return i;
+    }
+  }
+
+  // Index of the slot for `key`, claiming an empty one if the key is new;
+  // second is true when it was inserted. A new slot's other fields are
+  // reset to their default value.
+  std::pair<size_t, bool> Insert(const Key &key) {
+    uint64_t h = HashOf(key);
+    uint8_t tag = TagOf(h);
+    size_t i = h & mask;
+    for (; ctrl[i] != kEmpty; i = (i + 1) & mask)
+      if (ctrl[i] == tag && slots[i].key == key)
+        return {i, false};
+    // Only a new key can need more room, so an update at the load limit
+    // does not grow the table. After growing, probe again for an empty
+    // slot; the key is known to be absent.
+    if (size + 1 > MaxLoad(Capacity())) {
+      Rehash(Capacity() * 2);
+      i = h & mask;
+      while (ctrl[i] != kEmpty)
+        i = (i + 1) & mask;
+    }
+    slots[i] = Slot{};
+    slots[i].key = key;
+    ctrl[i] = tag;
+    ++size;
+    return {i, true};
+  }
+
+  // Empties slot i, then walks the rest of its probe run and moves back
+  // each entry whose home slot lies at or before the hole, so every probe
+  // still reaches its key before an empty slot.
+  void EraseAt(size_t i) {
+    for (size_t j = (i + 1) & mask; ctrl[j] != kEmpty; j = (j + 1) & mask) {
+      size_t home = HashOf(slots[j].key) & mask;
+      // Distance from home is measured cyclically, so this also holds when
+      // the run wraps past the end of the array.
+      if (((j - home) & mask) >= ((j - i) & mask)) {
+        slots[i] = std::move(slots[j]);
+        ctrl[i] = ctrl[j];
+        i = j;
+      }
+    }
+    ctrl[i] = kEmpty;
+    --size;
+  }
+
+  Slot &At(size_t i) { return slots[i]; }
+  const Slot &At(size_t i) const { return slots[i]; }
+
+  template <typename Fn> void ForEachSlot(Fn &&fn) const {
+    for (size_t i = 0; i < Capacity(); ++i)
+      if (ctrl[i] != kEmpty)
+        fn(slots[i]);
+  }
+
+private:
+  static constexpr uint8_t kEmpty = 0;
+
+  std::unique_ptr<uint8_t[]> ctrl; // kEmpty or 0x80 | hash tag, per slot
+  std::unique_ptr<Slot[]> slots;   // only slots with a full ctrl byte are live
+  size_t mask = 0;
+  size_t size = 0;
+
+  static uint64_t HashOf(const Key &key) {
+    return Mix(static_cast<uint64_t>(Hash{}(key)));
+  }
+  // The index uses the low bits of the hash and the tag the top 7.
+  static uint8_t TagOf(uint64_t h) {
+    return static_cast<uint8_t>(0x80 | (h >> 57));
+  }
+
+  static size_t MaxLoad(size_t capacity) { return capacity / 4 * 3; }
+  // Smallest power of two that holds `expected` keys within MaxLoad.
+  static size_t CapacityFor(size_t expected) {
+    return std::bit_ceil(std::max<size_t>(16, expected + expected / 3 + 1));
+  }
+
+  // Slots are default-initialized; only their control bytes are cleared.
+  void Allocate(size_t capacity) {
+    ctrl = std::make_unique_for_overwrite<uint8_t[]>(capacity);
+    slots = std::make_unique_for_overwrite<Slot[]>(capacity);
+    mask = capacity - 1;
+    Clear();
+  }
+
+  void Rehash(size_t capacity) {
+    std::unique_ptr<uint8_t[]> old_ctrl = std::move(ctrl);
+    std::unique_ptr<Slot[]> old_slots = std::move(slots);
+    size_t old_capacity = mask + 1;
+    Allocate(capacity);
+    for (size_t j = 0; j < old_capacity; ++j) {
+      if (old_ctrl[j] == kEmpty)
+        continue;
+      // Keys are unique, so each one only needs the first empty slot.
+      size_t i = HashOf(old_slots[j].key) & mask;
+      while (ctrl[i] != kEmpty)
+        i = (i + 1) & mask;
+      slots[i] = std::move(old_slots[j]);
+      ctrl[i] = old_ctrl[j];
+      ++size;
+    }
+  }
+};
+
+} // namespace flat_hash_detail
+
+template <typename K, typename V, typename Hash = std::hash<K>>
+class FlatHashMap {
+public:
+  // Sized so that `expected` keys fit without rehashing.
+  explicit FlatHashMap(size_t expected = 0) : table(expected) {}
+
+  size_t Size() const { return table.Size(); }
+  bool Empty() const { return table.Size() == 0; }
+  size_t Capacity() const { return table.Capacity(); }
+  void Reserve(size_t expected) { table.Reserve(expected); }
+  void Clear() { table.Clear(); }
+
+  // The value for `key`, inserting a default-constructed one if absent.
+  V &operator[](const K &key) {
+    return table.At(table.Insert(key).first).value;
+  }
+
+  // Adds (key, value) unless `key` is present; true when it was added.
+  bool Insert(const K &key, const V &value) {
+    auto [i, inserted] = table.Insert(key);
+    if (inserted)
+      table.At(i).value = value;
+    return inserted;
+  }
+
+  // Pointer to the value for `key`, or nullptr. Valid until the next insert.
+  V *Find(const K &key) {
+    size_t i = table.Find(key);
+    return i == Table::kNotFound ? nullptr : &table.At(i).value;
+  }
+  const V *Find(const K &key) const {
+    size_t i = table.Find(key);
+    return i == Table::kNotFound ? nullptr : &table.At(i).value;
+  }
+  bool Contains(const K &key) const {
+    return table.Find(key) != Table::kNotFound;
+  }
+
+  // Removes `key`; true when it was present. Invalidates pointers from Find.
+  bool Erase(const K &key) {
+    size_t i = table.Find(key);
+    if (i == Table::kNotFound)
+      return false;
+    table.EraseAt(i);
+    return true;
+  }
+
+  // Calls fn(key, value) for every entry, in no particular order.
+  template <typename Fn> void ForEach(Fn &&fn) const {
+    table.ForEachSlot([&](const auto &slot) { fn(slot.key, slot.value); });
+  }
+
+private:
+  using Table = flat_hash_detail::Table<flat_hash_detail::MapSlot<K, V>, Hash>;
+  Table table;
+};
+
+template <typename K, typename Hash = std::hash<K>> class FlatHashSet {
+public:
+  // Sized so that `expected` keys fit without rehashing.
+  explicit FlatHashSet(size_t expected = 0) : table(expected) {}
+
+  size_t Size() const { return table.Size(); }
+  bool Empty() const { return table.Size() == 0; }
+  size_t Capacity() const { return table.Capacity(); }
+  void Reserve(size_t expected) { table.Reserve(expected); }
+  void Clear() { table.Clear(); }
+
+  // Adds `key`; true when it was not already present.
+  bool Insert(const K &key) { return table.Insert(key).second; }
+  bool Contains(const K &key) const {
+    return table.Find(key) != Table::kNotFound;
+  }
+
+  // Removes `key`; true when it was present.
+  bool Erase(const K &key) {
+    size_t i = table.Find(key);
+    if (i == Table::kNotFound)
+      return false;
+    table.EraseAt(i);
+    return true;
+  }
+
+  // Calls fn(key) for every key, in no particular order.
+  template <typename Fn> void ForEach(Fn &&fn) const {
+    table.ForEachSlot([&](const auto &slot) { fn(slot.key); });
+  }
+
+private:
+  using Table = flat_hash_detail::Table<flat_hash_detail::SetSlot<K>, Hash>;
+  Table table;
+};
+
+#endif // FLAT_HASH_H
@@ -0,0 +1,568 @@
+//
+//  roaring_set.h
+//  DSA-Project
+//
+//  Created by richie on 10/19/26.
+//
+
+#ifndef ROARING_SET_H
+#define ROARING_SET_H
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "array.h"
+
+// Compressed set of 32-bit unsigned integers in the style of Roaring bitmaps
+// (Chambi, Lemire et al.). Values are grouped by their high 16 bits into
+// blocks of 65536; each non-empty block keeps its low 16 bits in whichever
+// container is smallest:
+//
+//   array   sorted uint16_t values, 2 bytes each (at most 4096 of them)
+//   bitmap  1024 x 64-bit words, 8 KB regardless of content
+//   run     sorted [start, last] intervals, 4 bytes each
+//
+// Set operations combine two sets block by block and never expand the whole
+// set: matching blocks are combined container to container, and at most one
+// 8 KB bitmap per block is built when the two containers have different
+// kinds. Containers are re-chosen after every operation.
+class RoaringSet {
+private:
+  struct Run {
+    uint16_t start;
+    uint16_t last; // inclusive, so a full block is {0, 65535}
+  };
+
+  struct Container {
+    enum class Kind { Array, Bitmap, Run };
+    Kind kind = Kind::Array;
+    std::vector<uint16_t> values; // Kind::Array
+    std::vector<uint64_t> bits;   // Kind::Bitmap, kBitmapWords words
+    std::vector<Run> runs;        // Kind::Run
+    uint32_t cardinality = 0;
+
+    bool Contains(uint16_t low) const;
+    size_t SizeInBytes() const;
+    template <typename Fn> void ForEach(Fn &&fn) const;
+  };
+
+  static constexpr size_t kBitmapWords = 65536 / 64;
+  static constexpr uint32_t kMaxArrayCardinality = 4096;
+
+  std::vector<uint16_t> keys; // high 16 bits of each block, ascending
+  std::vector<Container> containers;
+
+  // --- Container Helpers ---
+  static std::vector<uint64_t> ToBits(const Container &c);
+  static std::vector<uint16_t> ToValues(const Container &c);
+  static std::vector<Run> ToRuns(const Container &c);
+  static size_t CountRuns(const Container &c);
+  static void Normalize(Container &c);
+  static Container FromBits(std::vector<uint64_t> bits);
+  static Container FromValues(std::vector<uint16_t> values);
+  static Container FromRuns(std::vector<Run> runs);
+
+  enum class Op { Union, Intersection, Difference };
+  static Container Combine(const Container &x, const Container &y, Op op);
+  static std::vector<Run> CombineRuns(const std::vector<Run> &x,
+                                      const std::vector<Run> &y, Op op);
+  RoaringSet Combine(const RoaringSet &other, Op op) const;
+
+public:
+  RoaringSet() = default;
+
+  // Builds a set from an Array of non-negative integers below 2^32, sorted
+  // or not, duplicates allowed. Throws std::out_of_range otherwise.
+  template <typename T> static RoaringSet FromArray(const Array<T> &arr);
+  // All values in ascending order.
+  template <typename T> Array<T> ToArray() const;
+
+  void Add(uint32_t value);
+  bool Contains(uint32_t value) const;
+  uint64_t Cardinality() const;
+  bool Empty() const { return keys.empty(); }
+  // Heap bytes used by the containers, for comparing against 4 * n.
+  size_t SizeInBytes() const;
+
+  RoaringSet Union(const RoaringSet &other) const;
+  RoaringSet Intersection(const RoaringSet &other) const;
+  RoaringSet Difference(const RoaringSet &other) const;
+
+  // Calls fn(uint32_t) for every value in ascending order.
+  template <typename Fn> void ForEach(Fn &&fn) const;
+};
+
+// =================================================================================
+// ============================ CONTAINER HELPERS ==================================
+// =================================================================================
+
+inline bool RoaringSet::Container::Contains(uint16_t low) const {
+  switch (kind) {
+  case Kind::Array:
+    return std::binary_search(values.begin(), values.end(), low);
+  case Kind::Bitmap:
+    return (bits[low >> 6] >> (low & 63)) & 1;
+  case Kind::Run: {
+    // First run starting after `low`; the one before it may contain it.
+    auto it = std::upper_bound(
+        runs.begin(), runs.end(), low,
+        [](uint16_t v, const Run &r) { return v < r.start; });
+    return it != runs.begin() && low <= std::prev(it)->last;
+  }
+  }
+  return false;
+}
+
+inline size_t RoaringSet::Container::SizeInBytes() const {
+  return values.size() * sizeof(uint16_t) + bits.size() * sizeof(uint64_t) +
+         runs.size() * sizeof(Run);
+}
+
+template <typename Fn> void RoaringSet::Container::ForEach(Fn &&fn) const {
+  switch (kind) {
+  case Kind::Array:
+    for (uint16_t v : values)
+      fn(v);
+    break;
+  case Kind::Bitmap:
+    for (size_t w = 0; w < kBitmapWords; ++w) {
+      for (uint64_t word = bits[w]; word != 0; word &= word - 1)
+        fn(static_cast<uint16_t>(w * 64 + std::countr_zero(word)));
+    }
+    break;
+  case Kind::Run:
+    for (const Run &r : runs) {
+      for (uint32_t v = r.start; v <= r.last; ++v)
+        fn(static_cast<uint16_t>(v));
+    }
+    break;
+  }
+}
+
+inline std::vector<uint64_t> RoaringSet::ToBits(const Container &c) {
+  if (c.kind == Container::Kind::Bitmap)
+    return c.bits;
+  std::vector<uint64_t> bits(kBitmapWords, 0);
+  if (c.kind == Container::Kind::Array) {
+    for (uint16_t v : c.values)
+      bits[v >> 6] |= uint64_t(1) << (v & 63);
+    return bits;
+  }
+  for (const Run &r : c.runs) {
+    // Fill whole words at a time; only the two end words need masks.
+    size_t first = r.start >> 6, last = r.last >> 6;
+    uint64_t head = ~uint64_t(0) << (r.start & 63);
+    uint64_t tail = ~uint64_t(0) >> (63 - (r.last & 63));
+    if (first == last) {
+      bits[first] |= head & tail;
+      continue;
+    }
+    bits[first] |= head;
+    for (size_t w = first + 1; w < last; ++w)
+      bits[w] = ~uint64_t(0);
+    bits[last] |= tail;
+  }
+  return bits;
+}
+
+inline std::vector<uint16_t> RoaringSet::ToValues(const Container &c) {
+  if (c.kind == Container::Kind::Array)
+    return c.values;
+  std::vector<uint16_t> values;
+  values.reserve(c.cardinality);
+  c.ForEach([&](uint16_t v) { values.push_back(v); });
+  return values;
+}
+
+inline std::vector<RoaringSet::Run> RoaringSet::ToRuns(const Container &c) {
+  if (c.kind == Container::Kind::Run)
+    return c.runs;
+  std::vector<Run> runs;
+  if (c.kind == Container::Kind::Array) {
+    for (uint16_t v : c.values) {
+      if (!runs.empty() && runs.back().last + 1 == v)
+        runs.back().last = v;
+      else
+        runs.push_back({v, v});
+    }
+    return runs;
+  }
+  // Bitmap: jump between run boundaries with countr_zero instead of testing
+  // every bit.
+  uint32_t pos = 0;
+  while (pos < 65536) {
+    size_t w = pos >> 6;
+    uint64_t word = c.bits[w] & (~uint64_t(0) << (pos & 63));
+    while (word == 0 && ++w < kBitmapWords)
+      word = c.bits[w];
+    if (word == 0)
+      break;
+    uint32_t start = static_cast<uint32_t>(w * 64 + std::countr_zero(word));
+    // Find the first clear bit at or after `start`.
+    word = ~c.bits[w] & (~uint64_t(0) << (start & 63));
+    while (word == 0 && ++w < kBitmapWords)
+      word = ~c.bits[w];
+    uint32_t end =
+        word == 0 ? 65536 : static_cast<uint32_t>(w * 64 + std::countr_zero(word));
+    runs.push_back(
+        {static_cast<uint16_t>(start), static_cast<uint16_t>(end - 1)});
+    pos = end;
+  }
+  return runs;
+}
+
+inline size_t RoaringSet::CountRuns(const Container &c) {
+  switch (c.kind) {
+  case Container::Kind::Run:
+    return c.runs.size();
+  case Container::Kind::Array: {
+    size_t runs = c.values.empty() ? 0 : 1;
+    for (size_t i = 1; i < c.values.size(); ++i)
+      runs += c.values[i] != c.values[i - 1] + 1;
+    return runs;
+  }
+  case Container::Kind::Bitmap: {
+    // A run starts at every set bit whose lower neighbour is clear.
+    size_t runs = 0;
+    uint64_t carry = 0;
+    for (uint64_t word : c.bits) {
+      runs += std::popcount(word & ~((word << 1) | carry));
+      carry = word >> 63;
+    }
+    return runs;
+  }
+  }
+  return 0;
+}
+
+// Switches c to whichever container kind stores it in the fewest bytes.
+inline void RoaringSet::Normalize(Container &c) {
+  size_t run_bytes = CountRuns(c) * sizeof(Run);
+  size_t array_bytes = c.cardinality <= kMaxArrayCardinality
+                           ? c.cardinality * sizeof(uint16_t)
+                           : std::numeric_limits<size_t>::max();
+  size_t bitmap_bytes = kBitmapWords * sizeof(uint64_t);
+  Container::Kind best = Container::Kind::Bitmap;
+  if (array_bytes <= bitmap_bytes)
+    best = Container::Kind::Array;
+  if (run_bytes < std::min(array_bytes, bitmap_bytes))
+    best = Container::Kind::Run;
+  if (best == c.kind)
+    return;
+
+  Container next;
+  next.kind = best;
+  next.cardinality = c.cardinality;
+  if (best == Container::Kind::Array)
+    next.values = ToValues(c);
+  else if (best == Container::Kind::Bitmap)
+    next.bits = ToBits(c);
+  else
+    next.runs = ToRuns(c);
+  c = std::move(next);
+}
+
+inline RoaringSet::Container RoaringSet::FromBits(std::vector<uint64_t> bits) {
+  Container c;
+  c.kind = Container::Kind::Bitmap;
+  for (uint64_t word : bits)
+    c.cardinality += std::popcount(word);
+  c.bits = std::move(bits);
+  Normalize(c);
+  return c;
+}
+
+inline RoaringSet::Container
+RoaringSet::FromValues(std::vector<uint16_t> values) {
+  Container c;
+  c.kind = Container::Kind::Array;
+  c.cardinality = static_cast<uint32_t>(values.size());
+  c.values = std::move(values);
+  Normalize(c);
+  return c;
+}
+
+inline RoaringSet::Container RoaringSet::FromRuns(std::vector<Run> runs) {
+  Container c;
+  c.kind = Container::Kind::Run;
+  for (const Run &r : runs)
+    c.cardinality += uint32_t(r.last) - r.start + 1;
+  c.runs = std::move(runs);
+  Normalize(c);
+  return c;
+}
+
+// Interval algebra on two sorted, disjoint, non-adjacent run lists.
+inline std::vector<RoaringSet::Run>
+RoaringSet::CombineRuns(const std::vector<Run> &x, const std::vector<Run> &y,
+                        Op op) {
+  std::vector<Run> out;
+  auto append = [&](uint32_t start, uint32_t last) {
+    if (!out.empty() && uint32_t(out.back().last) + 1 >= start)
+      out.back().last = static_cast<uint16_t>(std::max<uint32_t>(
+          out.back().last, last));
+    else
+      out.push_back(
+          {static_cast<uint16_t>(start), static_cast<uint16_t>(last)});
+  };
+  size_t i = 0, j = 0;
+  if (op == Op::Union) {
+    while (i < x.size() || j < y.size()) {
+      bool take_x = j == y.size() || (i < x.size() && x[i].start <= y[j].start);
+      const Run &r = take_x ? x[i++] : y[j++];
+      append(r.start, r.last);
+    }
+  } else if (op == Op::Intersection) {
+    while (i < x.size() && j < y.size()) {
+      uint32_t start = std::max(x[i].start, y[j].start);
+      uint32_t last = std::min(x[i].last, y[j].last);
+      if (start <= last)
+        out.push_back(
+            {static_cast<uint16_t>(start), static_cast<uint16_t>(last)});
+      // Drop whichever run ends first; the other may overlap the next one.
+      if (x[i].last < y[j].last)
+        ++i;
+      else
+        ++j;
+    }
+  } else {
+    for (; i < x.size(); ++i) {
+      uint32_t start = x[i].start, last = x[i].last;
+      while (j < y.size() && y[j].last < start)
+        ++j;
+      // Cut every y run overlapping [start, last] out of it.
+      for (size_t k = j; k < y.size() && y[k].start <= last; ++k) {
+        if (y[k].start > start)
+          out.push_back({static_cast<uint16_t>(start),
+                         static_cast<uint16_t>(y[k].start - 1)});
+        start = uint32_t(y[k].last) + 1;
+      }
+      if (start <= last)
+        out.push_back(
+            {static_cast<uint16_t>(start), static_cast<uint16_t>(last)});
+    }
+  }
+  return out;
+}
+
+inline RoaringSet::Container RoaringSet::Combine(const Container &x,
+                                                 const Container &y, Op op) {
+  using Kind = Container::Kind;
+  if (x.kind == Kind::Run && y.kind == Kind::Run)
+    return FromRuns(CombineRuns(x.runs, y.runs, op));
+
+  if (x.kind == Kind::Array && y.kind == Kind::Array) {
+    std::vector<uint16_t> out(
+        (op == Op::Union ? x.values.size() + y.values.size()
+                         : x.values.size()) +
+        kSimdSetOutputSlack);
+    size_t n = 0;
+    const uint16_t *a = x.values.data(), *b = y.values.data();
+    size_t na = x.values.size(), nb = y.values.size();
+    if (op == Op::Union)
+      n = union_branchless(a, na, b, nb, out.data());
+    else if (op == Op::Intersection)
+      n = intersect_branchless(a, na, b, nb, out.data());
+    else
+      n = difference_branchless(a, na, b, nb, out.data());
+    out.resize(n);
+    return FromValues(std::move(out));
+  }
+
+  // A small array against anything else: probe the other container for
+  // each value instead of building a bitmap.
+  if (op != Op::Union && x.kind == Kind::Array) {
+    std::vector<uint16_t> out;
+    for (uint16_t v : x.values)
+      if (y.Contains(v) == (op == Op::Intersection))
+        out.push_back(v);
+    return FromValues(std::move(out));
+  }
+  if (op == Op::Intersection && y.kind == Kind::Array) {
+    std::vector<uint16_t> out;
+    for (uint16_t v : y.values)
+      if (x.Contains(v))
+        out.push_back(v);
+    return FromValues(std::move(out));
+  }
+
+  // Otherwise combine word by word. Bitmap inputs are used as they are; the
+  // other side is expanded into a single 8 KB block.
+  std::vector<uint64_t> bits = ToBits(x);
+  if (y.kind == Kind::Array && op == Op::Union) {
+    for (uint16_t v : y.values)
+      bits[v >> 6] |= uint64_t(1) << (v & 63);
+    return FromBits(std::move(bits));
+  }
+  if (y.kind == Kind::Array) { // Difference
+    for (uint16_t v : y.values)
+      bits[v >> 6] &= ~(uint64_t(1) << (v & 63));
+    return FromBits(std::move(bits));
+  }
+  std::vector<uint64_t> expanded;
+  const std::vector<uint64_t> &other =
+      y.kind == Kind::Bitmap ? y.bits : (expanded = ToBits(y));
+  for (size_t w = 0; w < kBitmapWords; ++w) {
+    if (op == Op::Union)
+      bits[w] |= other[w];
+    else if (op == Op::Intersection)
+      bits[w] &= other[w];
+    else
+      bits[w] &= ~other[w];
+  }
+  return FromBits(std::move(bits));
+}
+
+// =================================================================================
+// ============================== PUBLIC METHODS ===================================
+// =================================================================================
+
+template <typename T> RoaringSet RoaringSet::FromArray(const Array<T> &arr) {
+  static_assert(std::is_integral_v<T>, "RoaringSet holds integers");
+  std::vector<uint32_t> sorted;
+  sorted.reserve(arr.GetLength());
+  for (const T &v : arr) {
+    if constexpr (std::is_signed_v<T>) {
+      if (v < 0)
+        throw std::out_of_range("RoaringSet values must be non-negative.");
+    }
+    if (static_cast<std::make_unsigned_t<T>>(v) >
+        std::numeric_limits<uint32_t>::max())
+      throw std::out_of_range("RoaringSet values must fit in 32 bits.");
+    sorted.push_back(static_cast<uint32_t>(v));
+  }
+  if (!std::is_sorted(sorted.begin(), sorted.end()))
+    std::sort(sorted.begin(), sorted.end());
+  sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+  RoaringSet set;
+  for (size_t i = 0; i < sorted.size();) {
+    uint16_t key = static_cast<uint16_t>(sorted[i] >> 16);
+    std::vector<uint16_t> low;
+    for (; i < sorted.size() && (sorted[i] >> 16) == key; ++i)
+      low.push_back(static_cast<uint16_t>(sorted[i]));
+    set.keys.push_back(key);
+    set.containers.push_back(FromValues(std::move(low)));
+  }
+  return set;
+}
+
+template <typename T> Array<T> RoaringSet::ToArray() const {
+  Array<T> arr(static_cast<size_t>(Cardinality()));
+  ForEach([&](uint32_t v) { arr.Append(static_cast<T>(v)); });
+  return arr;
+}
+
+template <typename Fn> void RoaringSet::ForEach(Fn &&fn) const {
+  for (size_t b = 0; b < keys.size(); ++b) {
+    uint32_t high = uint32_t(keys[b]) << 16;
+    containers[b].ForEach([&](uint16_t low) { fn(high | low); });
+  }
+}
+
+inline void RoaringSet::Add(uint32_t value) {
+  uint16_t key = static_cast<uint16_t>(value >> 16);
+  uint16_t low = static_cast<uint16_t>(value);
+  auto it = std::lower_bound(keys.begin(), keys.end(), key);
+  size_t b = it - keys.begin();
+  if (it == keys.end() || *it != key) {
+    keys.insert(it, key);
+    containers.insert(containers.begin() + b, FromValues({low}));
+    return;
+  }
+  Container &c = containers[b];
+  if (c.Contains(low))
+    return;
+  if (c.kind == Container::Kind::Array) {
+    c.values.insert(std::lower_bound(c.values.begin(), c.values.end(), low),
+                    low);
+    c.cardinality++;
+    if (c.cardinality > kMaxArrayCardinality)
+      Normalize(c);
+  } else if (c.kind == Container::Kind::Bitmap) {
+    c.bits[low >> 6] |= uint64_t(1) << (low & 63);
+    c.cardinality++;
+  } else {
+    Container single;
+    single.values = {low};
+    single.cardinality = 1;
+    c = Combine(c, single, Op::Union);
+  }
+}
+
+inline bool RoaringSet::Contains(uint32_t value) const {
+  uint16_t key = static_cast<uint16_t>(value >> 16);
+  auto it = std::lower_bound(keys.begin(), keys.end(), key);
+  return it != keys.end() && *it == key &&
+         containers[it - keys.begin()].Contains(static_cast<uint16_t>(value));
+}
+
+inline uint64_t RoaringSet::Cardinality() const {
+  uint64_t total = 0;
+  for (const Container &c : containers)
+    total += c.cardinality;
+  return total;
+}
+
+inline size_t RoaringSet::SizeInBytes() const {
+  size_t bytes = keys.size() * sizeof(uint16_t);
+  for (const Container &c : containers)
+    bytes += c.SizeInBytes();
+  return bytes;
+}
+
+// Walks both key lists like a merge. Blocks present on one side only are
+// copied (union, difference) or skipped (intersection) without touching
+// their contents.
+inline RoaringSet RoaringSet::Combine(const RoaringSet &other, Op op) const {
+  RoaringSet out;
+  size_t i = 0, j = 0;
+  auto keep = [&](uint16_t key, Container c) {
+    if (c.cardinality == 0)
+      return;
+    out.keys.push_back(key);
+    out.containers.push_back(std::move(c));
+  };
+  while (i < keys.size() && j < other.keys.size()) {
+    if (keys[i] < other.keys[j]) {
+      if (op != Op::Intersection)
+        keep(keys[i], containers[i]);
+      ++i;
+    } else if (other.keys[j] < keys[i]) {
+      if (op == Op::Union)
+        keep(other.keys[j], other.containers[j]);
+      ++j;
+    } else {
+      keep(keys[i], Combine(containers[i], other.containers[j], op));
+      ++i;
+      ++j;
+    }
+  }
+  if (op != Op::Intersection)
+    for (; i < keys.size(); ++i)
+      keep(keys[i], containers[i]);
+  if (op == Op::Union)
+    for (; j < other.keys.size(); ++j)
+      keep(other.keys[j], other.containers[j]);
+  return out;
+}
+
+inline RoaringSet RoaringSet::Union(const RoaringSet &other) const {
+  return Combine(other, Op::Union);
+}
+
+inline RoaringSet RoaringSet::Intersection(const RoaringSet &other) const {
+  return Combine(other, Op::Intersection);
+}
+
+inline RoaringSet RoaringSet::Difference(const RoaringSet &other) const {
+  return Combine(other, Op::Difference);
+}
+
+#endif // ROARING_SET_H
@@ -0,0 +1,358 @@
+//
+//  sequence_check.h
+//  DSA-Project
+//
+//  Created by richie on 10/19/26.
+//
+
+#ifndef SEQUENCE_CHECK_H
+#define SEQUENCE_CHECK_H
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "../algo/presence_bitmap.h"
+#include "../algo/sequence_math.h"
+#include "array.h"
+
+// Single-pass checks of a stream against an expected range of integers
+// [first, first + count), such as the sequence numbers of a message stream.
+// Values arrive in chunks of any size and in any order, and are never
+// stored; the finders on Array need the whole input in memory instead.
+//
+//   SequenceDigest<T>   O(1) memory. Running count, sum, sum of squares and
+//                       XOR of the offsets, compared at the end with their
+//                       closed forms for the range. Names up to two missing
+//                       values, or one duplicated value in place of a
+//                       missing one; anything more is only detected.
+//   SequenceTracker<T>  count / 8 bytes. A presence bitmap that flags each
+//                       duplicate or out-of-range value as it arrives, and
+//                       can list every gap so far at any point.
+//
+// Values are handled as unsigned offsets from `first`, so the range may
+// start anywhere in T, including at negative values.
+
+// Why SequenceTracker flagged a value.
+enum class SequenceFlag { Duplicate, OutOfRange };
+
+// How a stream differs from its expected range: the values that never
+// arrived and the values that arrived more than once, each increasing.
+template <typename T> struct SequenceDiff {
+  std::vector<T> missing;
+  std::vector<T> duplicated;
+  bool operator==(const SequenceDiff &) const = default;
+};
+
+namespace sequence_detail {
+
+template <typename T> uint64_t Offset(const T &value, const T &first) {
+  using U = std::make_unsigned_t<T>;
+  return static_cast<U>(static_cast<U>(value) - static_cast<U>(first));
+}
+
+template <typename T> T Value(uint64_t offset, const T &first) {
+  using U = std::make_unsigned_t<T>;
+  return static_cast<T>(static_cast<U>(static_cast<U>(first) + offset));
+}
+
+// floor(sqrt(x)) for x >= 0. The floating-point root is within one of the
+// answer, and the two loops correct it.
+inline __int128 ISqrt(__int128 x) {
+  __int128 r = static_cast<__int128>(std::sqrt(static_cast<long double>(x)));
+  while (r > 0 && r * r > x)
+    --r;
+  while ((r + 1) * (r + 1) <= x)
+    ++r;
+  return r;
+}
+
+} // namespace sequence_detail
+
+// Largest range a SequenceDigest can check: the sum of squares of 2^42
+// offsets is the most that fits in its 128-bit accumulators.
+inline constexpr uint64_t kMaxSequenceDigestRange = uint64_t(1) << 42;
+
+// Checks that a stream holds each value of [first, first + count) exactly
+// once, in O(1) memory. Diagnose, after the last chunk, solves the
+// differences between the running sums and the range's closed forms:
+//
+//   count - 1 values   the XOR of the offsets is the missing one
+//   count - 2 values   a + b and a^2 + b^2 give the two missing ones
+//   count values       m - d and m^2 - d^2 give a duplicate d standing in
+//                      for a missing m
+//
+// The sum and XOR alone cannot separate two missing values (1 and 2 leave
+// the same sum and XOR as 0 and 3), which is why the sum of squares is kept
+// too; the equation that is not needed for the answer is used to check it.
+// Out-of-range values are counted and left out of the sums.
+template <typename T> class SequenceDigest {
+  static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool>,
+                "SequenceDigest requires an integer type.");
+
+public:
+  SequenceDigest(T first, uint64_t count) : first(first), count(count) {
+    if (count > kMaxSequenceDigestRange)
+      throw std::length_error("SequenceDigest range is larger than 2^42");
+  }
+
+  void Append(const T &value) {
+    uint64_t offset = sequence_detail::Offset(value, first);
+    if (offset >= count) {
+      ++out_of_range;
+      return;
+    }
+    ++seen;
+    sum += offset;
+    square_sum += static_cast<unsigned __int128>(offset) * offset;
+    xor_sum ^= offset;
+  }
+
+  void Append(std::span<const T> chunk) {
+    uint64_t in_range = 0, chunk_xor = 0;
+    unsigned __int128 chunk_sum = 0, chunk_square_sum = 0;
+    for (const T &value : chunk) {
+      uint64_t offset = sequence_detail::Offset(value, first);
+      // Out-of-range values add zero to every sum instead of taking a
+      // branch, so the loop runs at the same speed on any data.
+      uint64_t keep = uint64_t(0) - uint64_t(offset < count);
+      offset &= keep;
+      in_range += keep & 1;
+      chunk_sum += offset;
+      chunk_square_sum += static_cast<unsigned __int128>(offset) * offset;
+      chunk_xor ^= offset;
+    }
+    seen += in_range;
+    out_of_range += chunk.size() - in_range;
+    sum += chunk_sum;
+    square_sum += chunk_square_sum;
+    xor_sum ^= chunk_xor;
+  }
+
+  // In-range values seen so far, counting repeats.
+  uint64_t Seen() const { return seen; }
+  uint64_t OutOfRange() const { return out_of_range; }
+
+  // Whether every check passes: count values, and sums and XOR that match
+  // the range. A stream that differs from the range in one or two values
+  // always fails; one that differs in many could in principle pass.
+  bool Complete() const {
+    std::optional<SequenceDiff<T>> diff = Diagnose();
+    return diff && diff->missing.empty() && diff->duplicated.empty();
+  }
+
+  // The missing and duplicated values, when the stream is one of the cases
+  // above, with an empty diff for a complete stream. std::nullopt when the
+  // stream differs from the range by more than the digest can resolve.
+  std::optional<SequenceDiff<T>> Diagnose() const {
+    using Wide = __int128;
+    const Wide n = static_cast<Wide>(count);
+    // Differences of the expected sums from the seen ones. The seen sums
+    // can exceed the expected ones, so the subtraction wraps and the result
+    // is read back as signed.
+    const Wide d1 = static_cast<Wide>(sum_of_offsets(count) - sum);
+    const Wide d2 =
+        static_cast<Wide>(square_sum_of_offsets(count) - square_sum);
+    const uint64_t dx = xor_of_offsets(count) ^ xor_sum;
+    auto in_range = [&](Wide offset) { return offset >= 0 && offset < n; };
+    auto value_of = [&](Wide offset) {
+      return sequence_detail::Value(static_cast<uint64_t>(offset), first);
+    };
+
+    SequenceDiff<T> diff;
+    if (seen == count) {
+      if (d1 == 0 && d2 == 0 && dx == 0)
+        return diff;
+      // d1 = m - d and d2 = (m - d)(m + d).
+      if (d1 == 0 || d2 % d1 != 0)
+        return std::nullopt;
+      Wide plus = d2 / d1;
+      if (((plus + d1) & 1) != 0)
+        return std::nullopt;
+      Wide m = (plus + d1) / 2, d = (plus - d1) / 2;
+      if (!in_range(m) || !in_range(d) ||
+          (static_cast<uint64_t>(m) ^ static_cast<uint64_t>(d)) != dx)
+        return std::nullopt;
+      diff.missing.push_back(value_of(m));
+      diff.duplicated.push_back(value_of(d));
+      return diff;
+    }
+    if (seen + 1 == count) {
+      Wide m = static_cast<Wide>(dx);
+      if (!in_range(m) || d1 != m || d2 != m * m)
+        return std::nullopt;
+      diff.missing.push_back(value_of(m));
+      return diff;
+    }
+    if (seen + 2 == count) {
+      // Two offsets in the range give 0 <= a + b < 2n and a^2 + b^2 no more
+      // than (a + b)^2. Checked first, since duplicates can push d1 and d2
+      // far enough out that the products below would overflow.
+      if (d1 < 0 || d1 >= 2 * n || d2 < 0 || d2 > d1 * d1)
+        return std::nullopt;
+      // (a - b)^2 = 2(a^2 + b^2) - (a + b)^2.
+      Wide disc = 2 * d2 - d1 * d1;
+      if (disc <= 0)
+        return std::nullopt;
+      Wide r = sequence_detail::ISqrt(disc);
+      if (r * r != disc || ((d1 + r) & 1) != 0)
+        return std::nullopt;
+      Wide a = (d1 - r) / 2, b = (d1 + r) / 2;
+      if (!in_range(a) || !in_range(b) ||
+          (static_cast<uint64_t>(a) ^ static_cast<uint64_t>(b)) != dx)
+        return std::nullopt;
+      diff.missing.push_back(value_of(a));
+      diff.missing.push_back(value_of(b));
+      return diff;
+    }
+    return std::nullopt;
+  }
+
+private:
+  T first;
+  uint64_t count;
+  uint64_t seen = 0;
+  uint64_t out_of_range = 0;
+  unsigned __int128 sum = 0;
+  unsigned __int128 square_sum = 0;
+  uint64_t xor_sum = 0;
+};
+
+// Tracks which values of [first, first + count) a stream has delivered, in
+// one bit per value. Each chunk is checked as it arrives: a value already
+// seen, or outside the range, is passed to the caller's callback straight
+// away, and the gaps so far can be listed at any point.
+template <typename T> class SequenceTracker {
+  static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool>,
+                "SequenceTracker requires an integer type.");
+
+public:
+  SequenceTracker(T first, uint64_t count)
+      : first(first), count(count), words(presence_words(count), 0) {}
+
+  // Marks one value. Returns true if it is in range and new.
+  bool Append(const T &value) {
+    bool fresh = Mark(sequence_detail::Offset(value, first));
+    AdvancePrefix();
+    return fresh;
+  }
+
+  // Marks each value of the chunk, calling on_flag(value, SequenceFlag) for
+  // each one that is a duplicate or out of range, in stream order.
+  template <typename Fn>
+  void Append(std::span<const T> chunk, Fn &&on_flag) {
+    for (const T &value : chunk) {
+      uint64_t offset = sequence_detail::Offset(value, first);
+      if (Mark(offset))
+        continue;
+      on_flag(value, offset >= count ? SequenceFlag::OutOfRange
+                                     : SequenceFlag::Duplicate);
+    }
+    AdvancePrefix();
+  }
+
+  void Append(std::span<const T> chunk) {
+    Append(chunk, [](const T &, SequenceFlag) {});
+  }
+
+  // Distinct in-range values seen so far.
+  uint64_t Seen() const { return seen; }
+  uint64_t Duplicates() const { return duplicates; }
+  uint64_t OutOfRange() const { return out_of_range; }
+  bool Complete() const { return seen == count; }
+
+  // Length of the longest run first, first + 1, ... that has fully
+  // arrived: the stream's cumulative acknowledgement point. Amortized O(1),
+  // since it only moves forward over whole words.
+  uint64_t ContiguousPrefix() const {
+    if (full_words == words.size())
+      return count;
+    return std::min<uint64_t>(count, uint64_t(full_words) * 64 +
+                                         std::countr_one(words[full_words]));
+  }
+
+  // The values not yet seen, as [lo, hi) ranges in increasing order. The sink
+  // may return bool; returning false stops the scan.
+  template <ResultSink<MissingRange<T>> Sink>
+  void ForEachMissing(Sink &&sink) const {
+    for_each_clear_run(words.data(), count, [&](uint64_t lo, uint64_t hi) {
+      const MissingRange<T> gap{sequence_detail::Value(lo, first),
+                                sequence_detail::Value(hi, first)};
+      return invoke_sink(sink, gap);
+    });
+  }
+
+  std::vector<MissingRange<T>> Missing() const {
+    std::vector<MissingRange<T>> gaps;
+    ForEachMissing([&](const MissingRange<T> &gap) { gaps.push_back(gap); });
+    return gaps;
+  }
+
+private:
+  T first;
+  uint64_t count;
+  std::vector<uint64_t> words;
+  uint64_t seen = 0;
+  uint64_t duplicates = 0;
+  uint64_t out_of_range = 0;
+  size_t full_words = 0; // words[0, full_words) have every bit set
+
+  bool Mark(uint64_t offset) {
+    if (offset >= count) {
+      ++out_of_range;
+      return false;
+    }
+    uint64_t &word = words[offset >> 6];
+    uint64_t bit = uint64_t(1) << (offset & 63);
+    if (word & bit) {
+      ++duplicates;
+      return false;
+    }
+    word |= bit;
+    ++seen;
+    return true;
+  }
+
+  void AdvancePrefix() {
+    while (full_words < words.size() && words[full_words] == ~uint64_t(0))
+      ++full_words;
+  }
+};
+
+// Reads whitespace-separated values of T from `in` and passes them to
+// fn(std::span<const T>) in chunks of up to chunk_size, reusing one buffer,
+// so a file or socket can be checked without holding all of it. Stops at the
+// end of the input or the first token that does not parse. Returns the number
+// of values read.
+template <typename T, typename Fn>
+uint64_t ReadChunks(std::istream &in, size_t chunk_size, Fn &&fn) {
+  if (chunk_size == 0)
+    throw std::invalid_argument("ReadChunks chunk size must be positive");
+  std::vector<T> buffer;
+  buffer.reserve(chunk_size);
+  uint64_t total = 0;
+  T value;
+  while (in >> value) {
+    buffer.push_back(value);
+    if (buffer.size() == chunk_size) {
+      fn(std::span<const T>(buffer));
+      total += buffer.size();
+      buffer.clear();
+    }
+  }
+  if (!buffer.empty()) {
+    fn(std::span<const T>(buffer));
+    total += buffer.size();
+  }
+  return total;
+}
+
+#endif // SEQUENCE_CHECK_H
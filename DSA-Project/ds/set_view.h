@@ -0,0 +1,332 @@
+//
+//  set_view.h
+//  DSA-Project
+//
+//  Created by richie on 10/19/26.
+//
+
+#ifndef SET_VIEW_H
+#define SET_VIEW_H
+
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "array.h"
+
+// Lazy set expressions over sorted Arrays. SetUnion, SetIntersect and
+// SetDiff build an expression tree instead of computing anything:
+//
+//   auto expr = SetDiff(SetIntersect(SetUnion(a, b), c), d);
+//   size_t n = expr.Count();          // no allocation
+//   for (int v : expr) { ... }        // streams the result
+//   Array<int> result = expr.ToArray(); // the only allocation
+//
+// Evaluation walks every input once, in one fused pass. Each node keeps a
+// cursor on its current output value. An intersection or difference seeks
+// its inputs forward with galloping search, so a selective node skips most of
+// the input below it. An intersection stops as soon as either side runs out.
+//
+// Results match the chained Array calls exactly, duplicates included.
+// Views hold references to their Arrays, which must outlive the view.
+
+template <typename T> class SortedArrayView;
+
+namespace set_view_detail {
+
+template <typename V>
+concept SetView = requires(const V &v) {
+  typename V::value_type;
+  v.MakeCursor();
+};
+
+template <typename T> SortedArrayView<T> AsView(const Array<T> &arr) {
+  return SortedArrayView<T>(arr);
+}
+
+template <SetView V> const V &AsView(const V &view) { return view; }
+
+template <typename X>
+using ViewOf = std::remove_cvref_t<decltype(AsView(std::declval<const X &>()))>;
+
+} // namespace set_view_detail
+
+// Operations shared by every view; Derived provides MakeCursor(). A cursor
+// exposes Valid(), Value(), Next() and Seek(key), which moves to the first
+// output value not less than key.
+template <typename Derived, typename T> class SetViewBase {
+public:
+  using value_type = T;
+
+  class Iterator {
+  public:
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+
+    Iterator() = default;
+    explicit Iterator(const Derived &view) : cursor(view.MakeCursor()) {}
+
+    const T &operator*() const { return cursor.Value(); }
+    Iterator &operator++() {
+      cursor.Next();
+      return *this;
+    }
+    void operator++(int) { cursor.Next(); }
+    bool operator==(std::default_sentinel_t) const { return !cursor.Valid(); }
+
+  private:
+    typename Derived::Cursor cursor;
+  };
+
+  Iterator begin() const { return Iterator(Self()); }
+  std::default_sentinel_t end() const { return {}; }
+
+  // Stops at the first result value.
+  bool Empty() const { return !Self().MakeCursor().Valid(); }
+
+  size_t Count() const {
+    size_t n = 0;
+    for (auto c = Self().MakeCursor(); c.Valid(); c.Next())
+      ++n;
+    return n;
+  }
+
+  // Calls fn(value) for each result value. If fn returns bool, returning
+  // false stops the walk early.
+  template <typename Fn> void ForEach(Fn &&fn) const {
+    for (auto c = Self().MakeCursor(); c.Valid(); c.Next())
+      if (!invoke_sink(fn, c.Value()))
+        return;
+  }
+
+  // Counts the result first, so the output buffer is allocated once at its
+  // exact size.
+  Array<T> ToArray() const {
+    Array<T> out(Count());
+    for (auto c = Self().MakeCursor(); c.Valid(); c.Next())
+      out.Append(c.Value());
+    return out;
+  }
+
+private:
+  const Derived &Self() const { return static_cast<const Derived &>(*this); }
+};
+
+// Leaf of an expression: a sorted Array.
+template <typename T>
+class SortedArrayView : public SetViewBase<SortedArrayView<T>, T> {
+public:
+  explicit SortedArrayView(const Array<T> &arr)
+      : first(arr.begin()), length(arr.GetLength()) {}
+
+  class Cursor {
+  public:
+    Cursor() = default;
+    Cursor(const T *first, size_t length) : first(first), length(length) {}
+    bool Valid() const { return pos < length; }
+    const T &Value() const { return first[pos]; }
+    void Next() { ++pos; }
+    void Seek(const T &key) {
+      pos = gallop_lower_bound(first, pos, length, key);
+    }
+
+  private:
+    const T *first = nullptr;
+    size_t length = 0, pos = 0;
+  };
+
+  Cursor MakeCursor() const { return Cursor(first, length); }
+
+private:
+  const T *first;
+  size_t length;
+};
+
+template <typename L, typename R>
+class UnionView : public SetViewBase<UnionView<L, R>, typename L::value_type> {
+public:
+  using T = typename L::value_type;
+  UnionView(L left, R right) : left(std::move(left)), right(std::move(right)) {}
+
+  class Cursor {
+  public:
+    Cursor() = default;
+    Cursor(typename L::Cursor l, typename R::Cursor r)
+        : l(std::move(l)), r(std::move(r)) {}
+    bool Valid() const { return l.Valid() || r.Valid(); }
+    // Equal values come from the left, like Array::Union.
+    const T &Value() const { return TakeLeft() ? l.Value() : r.Value(); }
+    void Next() {
+      if (!r.Valid())
+        l.Next();
+      else if (!l.Valid())
+        r.Next();
+      else if (l.Value() < r.Value())
+        l.Next();
+      else if (r.Value() < l.Value())
+        r.Next();
+      else {
+        l.Next();
+        r.Next();
+      }
+    }
+    void Seek(const T &key) {
+      l.Seek(key);
+      r.Seek(key);
+    }
+
+  private:
+    typename L::Cursor l;
+    typename R::Cursor r;
+    bool TakeLeft() const {
+      return !r.Valid() || (l.Valid() && !(r.Value() < l.Value()));
+    }
+  };
+
+  Cursor MakeCursor() const {
+    return Cursor(left.MakeCursor(), right.MakeCursor());
+  }
+
+private:
+  L left;
+  R right;
+};
+
+template <typename L, typename R>
+class IntersectView
+    : public SetViewBase<IntersectView<L, R>, typename L::value_type> {
+public:
+  using T = typename L::value_type;
+  IntersectView(L left, R right)
+      : left(std::move(left)), right(std::move(right)) {}
+
+  class Cursor {
+  public:
+    Cursor() = default;
+    Cursor(typename L::Cursor l, typename R::Cursor r)
+        : l(std::move(l)), r(std::move(r)) {
+      Align();
+    }
+    bool Valid() const { return l.Valid() && r.Valid(); }
+    const T &Value() const { return l.Value(); }
+    void Next() {
+      l.Next();
+      r.Next();
+      Align();
+    }
+    void Seek(const T &key) {
+      l.Seek(key);
+      r.Seek(key);
+      Align();
+    }
+
+  private:
+    typename L::Cursor l;
+    typename R::Cursor r;
+    // Leapfrogs the two sides until they agree or one runs out.
+    void Align() {
+      while (l.Valid() && r.Valid()) {
+        if (l.Value() < r.Value())
+          l.Seek(r.Value());
+        else if (r.Value() < l.Value())
+          r.Seek(l.Value());
+        else
+          return;
+      }
+    }
+  };
+
+  Cursor MakeCursor() const {
+    return Cursor(left.MakeCursor(), right.MakeCursor());
+  }
+
+private:
+  L left;
+  R right;
+};
+
+template <typename L, typename R>
+class DiffView : public SetViewBase<DiffView<L, R>, typename L::value_type> {
+public:
+  using T = typename L::value_type;
+  DiffView(L left, R right) : left(std::move(left)), right(std::move(right)) {}
+
+  class Cursor {
+  public:
+    Cursor() = default;
+    Cursor(typename L::Cursor l, typename R::Cursor r)
+        : l(std::move(l)), r(std::move(r)) {
+      Align();
+    }
+    bool Valid() const { return l.Valid(); }
+    const T &Value() const { return l.Value(); }
+    void Next() {
+      l.Next();
+      Align();
+    }
+    void Seek(const T &key) {
+      l.Seek(key);
+      Align();
+    }
+
+  private:
+    typename L::Cursor l;
+    typename R::Cursor r;
+    // Skips left values that a right value cancels, one for one.
+    void Align() {
+      while (l.Valid()) {
+        r.Seek(l.Value());
+        if (!r.Valid() || l.Value() < r.Value())
+          return;
+        l.Next();
+        r.Next();
+      }
+    }
+  };
+
+  Cursor MakeCursor() const {
+    return Cursor(left.MakeCursor(), right.MakeCursor());
+  }
+
+private:
+  L left;
+  R right;
+};
+
+// --- Factories: each argument is a sorted Array or another view ---
+
+template <typename A, typename B>
+UnionView<set_view_detail::ViewOf<A>, set_view_detail::ViewOf<B>>
+SetUnion(const A &a, const B &b) {
+  return {set_view_detail::AsView(a), set_view_detail::AsView(b)};
+}
+
+template <typename A, typename B>
+IntersectView<set_view_detail::ViewOf<A>, set_view_detail::ViewOf<B>>
+SetIntersect(const A &a, const B &b) {
+  return {set_view_detail::AsView(a), set_view_detail::AsView(b)};
+}
+
+template <typename A, typename B>
+DiffView<set_view_detail::ViewOf<A>, set_view_detail::ViewOf<B>>
+SetDiff(const A &a, const B &b) {
+  return {set_view_detail::AsView(a), set_view_detail::AsView(b)};
+}
+
+// A view must not outlive its Arrays, so temporaries are rejected.
+template <typename T, typename B>
+void SetUnion(const Array<T> &&, const B &) = delete;
+template <typename A, typename T>
+void SetUnion(const A &, const Array<T> &&) = delete;
+template <typename T, typename B>
+void SetIntersect(const Array<T> &&, const B &) = delete;
+template <typename A, typename T>
+void SetIntersect(const A &, const Array<T> &&) = delete;
+template <typename T, typename B>
+void SetDiff(const Array<T> &&, const B &) = delete;
+template <typename A, typename T>
+void SetDiff(const A &, const Array<T> &&) = delete;
+
+#endif // SET_VIEW_H
@@ -0,0 +1,442 @@
+//
+//  sketches.h
+//  DSA-Project
+//
+//  Created by richie on 10/19/26.
+//
+
+#ifndef SKETCHES_H
+#define SKETCHES_H
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <vector>
+
+#include "array.h"
+#include "flat_hash.h"
+
+// Fixed-size summaries of a stream, for when an approximate answer will do
+// and the exact finders on Array (FindDuplicatesHashing,
+// ParallelCountFrequencies) would need memory for every distinct value:
+//
+//   HyperLogLog<T>    how many distinct values          2^p bytes
+//   CountMinSketch<T> how often a given value occurs    width * depth words
+//   SpaceSaving<T>    which values occur most often     k counters
+//   BloomFilter<T>    whether a value has occurred      m bits
+//
+// Each one is fed with Append, one value at a time, or built in one call
+// with FromArray. Sketches with the same parameters can be merged, so shards
+// of a stream can be summarized separately and combined afterwards; the
+// merged sketch is the one a single pass over all shards would have built
+// (SpaceSaving keeps the same error bound rather than the same counters).
+// Merging sketches with different parameters throws std::invalid_argument.
+
+namespace sketch_detail {
+
+// 64-bit hash of a value. The offset keeps 0, which std::hash maps to 0 and
+// Mix leaves fixed, from hashing to all zero bits.
+template <typename T> uint64_t Hash(const T &value) {
+  return flat_hash_detail::Mix(static_cast<uint64_t>(std::hash<T>{}(value)) +
+                               0x9e3779b97f4a7c15ULL);
+}
+
+// Step for double hashing, h1 + i * h2. Odd, so that on a power-of-two
+// table the probes of one value land on different slots.
+inline uint64_t Step(uint64_t h) {
+  return flat_hash_detail::Mix(h ^ 0xc2b2ae3d27d4eb4fULL) | 1;
+}
+
+} // namespace sketch_detail
+
+// Estimates the number of distinct values seen, with a standard error of
+// about 1.04 / sqrt(2^precision): 0.8% at the default precision of 14, for
+// 16 KiB. The top `precision` bits of each hash pick a register, and the
+// register keeps the longest run of leading zeros seen in the remaining
+// bits. Merging takes the larger of each pair of registers.
+template <typename T> class HyperLogLog {
+public:
+  explicit HyperLogLog(unsigned precision = 14)
+      : precision(precision) {
+    if (precision < 4 || precision > 18)
+      throw std::invalid_argument("HyperLogLog precision must be in [4, 18]");
+    registers.assign(size_t(1) << precision, 0);
+  }
+
+  static HyperLogLog FromArray(const Array<T> &arr, unsigned precision = 14) {
+    HyperLogLog sketch(precision);
+    for (const T &value : arr)
+      sketch.Append(value);
+    return sketch;
+  }
+
+  void Append(const T &value) {
+    uint64_t h = sketch_detail::Hash(value);
+    size_t index = static_cast<size_t>(h >> (64 - precision));
+    // The sentinel bit caps the rank at 64 - precision + 1.
+    uint64_t rest = (h << precision) | (uint64_t(1) << (precision - 1));
+    uint8_t rank = static_cast<uint8_t>(std::countl_zero(rest) + 1);
+    registers[index] = std::max(registers[index], rank);
+  }
+
+  void Merge(const HyperLogLog &other) {
+    if (other.precision != precision)
+      throw std::invalid_argument("HyperLogLog precisions differ");
+    for (size_t i = 0; i < registers.size(); ++i)
+      registers[i] = std::max(registers[i], other.registers[i]);
+  }
+
+  // Harmonic mean of the registers, with the linear-counting correction for
+  // small cardinalities, where many registers are still zero. A 64-bit hash
+  // needs no large-range correction.
+  double Estimate() const {
+    const double m = static_cast<double>(registers.size());
+    double sum = 0;
+    size_t zeros = 0;
+    for (uint8_t r : registers) {
+      sum += std::ldexp(1.0, -r);
+      zeros += r == 0;
+    }
+    double alpha = registers.size() == 16   ? 0.673
+                   : registers.size() == 32 ? 0.697
+                   : registers.size() == 64 ? 0.709
+                                            : 0.7213 / (1 + 1.079 / m);
+    double estimate = alpha * m * m / sum;
+    if (estimate <= 2.5 * m && zeros != 0)
+      estimate = m * std::log(m / static_cast<double>(zeros));
+    return estimate;
+  }
+
+  unsigned Precision() const { return precision; }
+  double StandardError() const {
+    return 1.04 / std::sqrt(static_cast<double>(registers.size()));
+  }
+  size_t SizeInBytes() const { return registers.size(); }
+
+private:
+  unsigned precision;
+  std::vector<uint8_t> registers;
+};
+
+// Estimates how often each value occurs. `depth` rows of `width` counters
+// each; a value adds its count to one counter per row, and its estimate is
+// the smallest of those counters. Estimates never fall below the true count.
+// With width = e / epsilon and depth = ln(1 / delta), an estimate exceeds the
+// true count by more than epsilon * TotalCount() with probability at most
+// delta. Merging adds the counters.
+template <typename T> class CountMinSketch {
+public:
+  // The width is rounded up to a power of two.
+  CountMinSketch(size_t width, size_t depth)
+      : width(std::bit_ceil(std::max<size_t>(width, 1))), depth(depth) {
+    if (depth == 0)
+      throw std::invalid_argument("CountMinSketch depth must be positive");
+    counters.assign(this->width * depth, 0);
+  }
+
+  // The smallest sketch with the (epsilon, delta) guarantee above.
+  static CountMinSketch WithErrorBounds(double epsilon, double delta) {
+    if (!(epsilon > 0 && epsilon < 1) || !(delta > 0 && delta < 1))
+      throw std::invalid_argument("CountMinSketch bounds must be in (0, 1)");
+    return CountMinSketch(
+        static_cast<size_t>(std::ceil(std::exp(1.0) / epsilon)),
+        static_cast<size_t>(std::ceil(std::log(1 / delta))));
+  }
+
+  static CountMinSketch FromArray(const Array<T> &arr, size_t width,
+                                  size_t depth) {
+    CountMinSketch sketch(width, depth);
+    for (const T &value : arr)
+      sketch.Append(value);
+    return sketch;
+  }
+
+  void Append(const T &value, uint64_t count = 1) {
+    uint64_t h = sketch_detail::Hash(value), step = sketch_detail::Step(h);
+    for (size_t row = 0; row < depth; ++row, h += step)
+      counters[row * width + (h & (width - 1))] += count;
+    total += count;
+  }
+
+  uint64_t Estimate(const T &value) const {
+    uint64_t h = sketch_detail::Hash(value), step = sketch_detail::Step(h);
+    uint64_t estimate = UINT64_MAX;
+    for (size_t row = 0; row < depth; ++row, h += step)
+      estimate = std::min(estimate, counters[row * width + (h & (width - 1))]);
+    return estimate;
+  }
+
+  void Merge(const CountMinSketch &other) {
+    if (other.width != width || other.depth != depth)
+      throw std::invalid_argument("CountMinSketch dimensions differ");
+    for (size_t i = 0; i < counters.size(); ++i)
+      counters[i] += other.counters[i];
+    total += other.total;
+  }
+
+  size_t Width() const { return width; }
+  size_t Depth() const { return depth; }
+  uint64_t TotalCount() const { return total; }
+  size_t SizeInBytes() const { return counters.size() * sizeof(uint64_t); }
+
+private:
+  size_t width, depth;
+  uint64_t total = 0;
+  std::vector<uint64_t> counters; // row-major, depth x width
+};
+
+// Tracks the values that occur most often using `capacity` counters. A new
+// value takes a free counter, or else replaces the value with the smallest
+// count and inherits that count as its error. Any value occurring more than
+// TotalCount() / capacity times is guaranteed to be tracked, and a tracked
+// value's true count lies in [count - error, count].
+//
+// Counters stay in place; a min-heap of counter indices orders them by
+// count, and a hash index maps each value to its counter. Moving an index
+// within the heap therefore never rehashes a value, and each Append costs
+// one or two hash operations plus O(log capacity) heap steps. Merging
+// follows Agarwal et al., "Mergeable Summaries": counts are added, a value
+// missing from a full summary is charged that summary's minimum, and the
+// largest `capacity` are kept.
+template <typename T> class SpaceSaving {
+public:
+  struct Counter {
+    T value;
+    uint64_t count;
+    uint64_t error; // count overstates the true count by at most this
+
+    bool operator==(const Counter &) const = default;
+  };
+
+  explicit SpaceSaving(size_t capacity) : capacity(capacity), slot(capacity) {
+    if (capacity == 0)
+      throw std::invalid_argument("SpaceSaving capacity must be positive");
+    counters.reserve(capacity);
+    heap.reserve(capacity);
+    position.reserve(capacity);
+  }
+
+  static SpaceSaving FromArray(const Array<T> &arr, size_t capacity) {
+    SpaceSaving summary(capacity);
+    for (const T &value : arr)
+      summary.Append(value);
+    return summary;
+  }
+
+  void Append(const T &value) {
+    ++total;
+    if (const size_t *id = slot.Find(value)) {
+      ++counters[*id].count;
+      SiftDown(position[*id]);
+    } else if (counters.size() < capacity) {
+      slot[value] = counters.size();
+      counters.push_back({value, 1, 0});
+      position.push_back(heap.size());
+      heap.push_back(counters.size() - 1);
+      SiftUp(heap.size() - 1);
+    } else {
+      size_t id = heap[0];
+      Counter &evicted = counters[id];
+      slot.Erase(evicted.value);
+      evicted = {value, evicted.count + 1, evicted.count};
+      slot[value] = id;
+      SiftDown(0);
+    }
+  }
+
+  // An upper bound on the count of `value`: its counter if tracked, else the
+  // smallest count, which no untracked value can exceed.
+  uint64_t Estimate(const T &value) const {
+    if (const size_t *id = slot.Find(value))
+      return counters[*id].count;
+    return MinCount();
+  }
+
+  // Up to k tracked values with the largest counts, largest first. Ties are
+  // broken by the smaller error.
+  std::vector<Counter> TopK(size_t k) const {
+    std::vector<Counter> out = counters;
+    k = std::min(k, out.size());
+    auto larger = [](const Counter &a, const Counter &b) {
+      return a.count != b.count ? a.count > b.count : a.error < b.error;
+    };
+    std::partial_sort(out.begin(), out.begin() + k, out.end(), larger);
+    out.resize(k);
+    return out;
+  }
+
+  void Merge(const SpaceSaving &other) {
+    if (other.capacity != capacity)
+      throw std::invalid_argument("SpaceSaving capacities differ");
+    const uint64_t own_min = MinCount(), other_min = other.MinCount();
+    std::vector<Counter> merged;
+    merged.reserve(counters.size() + other.counters.size());
+    for (const Counter &c : counters) {
+      const size_t *j = other.slot.Find(c.value);
+      merged.push_back(j ? Counter{c.value, c.count + other.counters[*j].count,
+                                   c.error + other.counters[*j].error}
+                         : Counter{c.value, c.count + other_min,
+                                   c.error + other_min});
+    }
+    for (const Counter &c : other.counters)
+      if (!slot.Contains(c.value))
+        merged.push_back({c.value, c.count + own_min, c.error + own_min});
+    if (merged.size() > capacity) {
+      std::nth_element(merged.begin(), merged.begin() + capacity, merged.end(),
+                       [](const Counter &a, const Counter &b) {
+                         return a.count > b.count;
+                       });
+      merged.resize(capacity);
+    }
+    counters = std::move(merged);
+    total += other.total;
+    slot.Clear();
+    heap.resize(counters.size());
+    position.resize(counters.size());
+    for (size_t id = 0; id < counters.size(); ++id) {
+      slot[counters[id].value] = id;
+      heap[id] = position[id] = id;
+    }
+    for (size_t i = heap.size() / 2; i-- > 0;)
+      SiftDown(i);
+  }
+
+  size_t Capacity() const { return capacity; }
+  size_t Size() const { return counters.size(); }
+  uint64_t TotalCount() const { return total; }
+
+private:
+  size_t capacity;
+  uint64_t total = 0;
+  std::vector<Counter> counters;
+  std::vector<size_t> heap;     // counter ids, a min-heap on count
+  std::vector<size_t> position; // counter id -> index in heap
+  FlatHashMap<T, size_t> slot;  // value -> counter id
+
+  // Zero until every counter is in use: a value that was never seen could
+  // only have been evicted from a full summary.
+  uint64_t MinCount() const {
+    return counters.size() < capacity ? 0 : counters[heap[0]].count;
+  }
+
+  uint64_t CountAt(size_t i) const { return counters[heap[i]].count; }
+  void Place(size_t i, size_t id) {
+    heap[i] = id;
+    position[id] = i;
+  }
+  void SiftUp(size_t i) {
+    size_t id = heap[i];
+    while (i > 0 && counters[id].count < CountAt((i - 1) / 2)) {
+      size_t parent = (i - 1) / 2;
+      Place(i, heap[parent]);
+      i = parent;
+    }
+    Place(i, id);
+  }
+  void SiftDown(size_t i) {
+    size_t id = heap[i];
+    for (;;) {
+      size_t child = 2 * i + 1;
+      if (child >= heap.size())
+        break;
+      if (child + 1 < heap.size() && CountAt(child + 1) < CountAt(child))
+        ++child;
+      if (!(CountAt(child) < counters[id].count))
+        break;
+      Place(i, heap[child]);
+      i = child;
+    }
+    Place(i, id);
+  }
+};
+
+// Answers "has this value been appended?" with no false negatives and a
+// tunable false-positive rate. Each value sets `hashes` bits of an m-bit
+// array, chosen by double hashing; a lookup reports true only if all of them
+// are set. Merging ORs the bit arrays.
+template <typename T> class BloomFilter {
+public:
+  // The bit count is rounded up to a multiple of 64.
+  BloomFilter(size_t bits, unsigned hashes)
+      : bits((std::max<size_t>(bits, 1) + 63) / 64 * 64), hashes(hashes) {
+    if (hashes == 0)
+      throw std::invalid_argument("BloomFilter needs at least one hash");
+    words.assign(this->bits / 64, 0);
+  }
+
+  // Sized for `expected` values at the given false-positive rate:
+  // m = -n ln(p) / ln(2)^2 bits and k = (m / n) ln(2) hashes.
+  static BloomFilter ForCapacity(size_t expected, double false_positive_rate) {
+    if (!(false_positive_rate > 0 && false_positive_rate < 1))
+      throw std::invalid_argument("BloomFilter rate must be in (0, 1)");
+    double n = static_cast<double>(std::max<size_t>(expected, 1));
+    double ln2 = std::log(2.0);
+    double m = std::ceil(-n * std::log(false_positive_rate) / (ln2 * ln2));
+    unsigned k = static_cast<unsigned>(std::max(1.0, std::round(m / n * ln2)));
+    return BloomFilter(static_cast<size_t>(m), k);
+  }
+
+  static BloomFilter FromArray(const Array<T> &arr,
+                               double false_positive_rate = 0.01) {
+    BloomFilter filter = ForCapacity(arr.GetLength(), false_positive_rate);
+    for (const T &value : arr)
+      filter.Append(value);
+    return filter;
+  }
+
+  void Append(const T &value) {
+    uint64_t h = sketch_detail::Hash(value), step = sketch_detail::Step(h);
+    for (unsigned i = 0; i < hashes; ++i, h += step) {
+      size_t bit = BitOf(h);
+      words[bit >> 6] |= uint64_t(1) << (bit & 63);
+    }
+  }
+
+  bool MayContain(const T &value) const {
+    uint64_t h = sketch_detail::Hash(value), step = sketch_detail::Step(h);
+    for (unsigned i = 0; i < hashes; ++i, h += step) {
+      size_t bit = BitOf(h);
+      if (!(words[bit >> 6] >> (bit & 63) & 1))
+        return false;
+    }
+    return true;
+  }
+
+  void Merge(const BloomFilter &other) {
+    if (other.bits != bits || other.hashes != hashes)
+      throw std::invalid_argument("BloomFilter dimensions differ");
+    for (size_t i = 0; i < words.size(); ++i)
+      words[i] |= other.words[i];
+  }
+
+  // False-positive rate implied by the current fill: (set bits / m)^k.
+  double EstimatedFalsePositiveRate() const {
+    size_t set = 0;
+    for (uint64_t w : words)
+      set += std::popcount(w);
+    return std::pow(static_cast<double>(set) / static_cast<double>(bits),
+                    hashes);
+  }
+
+  size_t BitCount() const { return bits; }
+  unsigned HashCount() const { return hashes; }
+  size_t SizeInBytes() const { return words.size() * sizeof(uint64_t); }
+
+private:
+  size_t bits;
+  unsigned hashes;
+  std::vector<uint64_t> words;
+
+  // Maps a hash onto [0, bits) with a multiply and shift rather than a
+  // modulo, so the size need not be a power of two.
+  size_t BitOf(uint64_t h) const {
+    return static_cast<size_t>((static_cast<unsigned __int128>(h) * bits) >>
+                               64);
+  }
+};
+
+#endif // SKETCHES_H
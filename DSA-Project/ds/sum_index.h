@@ -0,0 +1,418 @@
+//
+//  sum_index.h
+//  DSA-Project
+//
+//  Created by richie on 10/19/26.
+//
+
+#ifndef SUM_INDEX_H
+#define SUM_INDEX_H
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../algo/parallel.h"
+#include "array.h"
+#include "flat_hash.h"
+
+// A prepared index over an Array's values for answering many k-sum queries:
+// is there a pair summing to k, how many pairs, triples or quadruples do,
+// and which ones. Array::PairWithSum_Sorted and PairWithSum_Hashing answer
+// one target and rebuild their state each call; SumIndex sorts once and is
+// then read-only, so batches of targets can be answered from many threads.
+//
+// The index keeps the distinct values in increasing order with their
+// multiplicities, plus a hash index from value to position. Queries are
+// two-pointer scans over the distinct values:
+//
+//   pairs       O(d) per target
+//   triples     O(d^2)
+//   quadruples  O(d^3)
+//
+// where d is the number of distinct values. A tuple may use a value as many
+// times as it occurs in the Array. Sums are formed in a wider type, so they
+// do not overflow for integers.
+//
+// Enumeration reports each multiset of values once, in increasing order
+// within the tuple; counting reports the number of index tuples
+// i1 < i2 < ... that sum to the target, so repeated values are counted with
+// their multiplicity.
+
+namespace sum_index_detail {
+
+// C(m, r) for the small r used by 2-, 3- and 4-sums.
+inline uint64_t Choose(uint64_t m, size_t r) {
+  if (m < r)
+    return 0;
+  uint64_t result = 1;
+  for (size_t i = 0; i < r; ++i)
+    result = result * (m - i) / (i + 1);
+  return result;
+}
+
+} // namespace sum_index_detail
+
+template <typename T> class SumIndex {
+  static_assert(std::is_arithmetic_v<T>, "SumIndex requires numeric values");
+
+public:
+  // Integers are summed in a type that holds four of them.
+  using Sum = std::conditional_t<std::is_floating_point_v<T>, T,
+                                 std::conditional_t<sizeof(T) <= 4, int64_t,
+                                                    __int128>>;
+  using Pair = std::pair<T, T>;
+  using Triple = std::array<T, 3>;
+  using Quad = std::array<T, 4>;
+
+  explicit SumIndex(const Array<T> &arr);
+
+  size_t Size() const { return size; }
+  size_t DistinctCount() const { return values.size(); }
+  // How many times `value` occurs in the indexed Array.
+  size_t Count(const T &value) const;
+
+  // --- Single targets ---
+  // Some pair of elements summing to k, smaller value first.
+  std::optional<Pair> FindPair(const T &k) const;
+  uint64_t CountPairs(const T &k) const { return CountTuples<2>(k); }
+  uint64_t CountTriples(const T &k) const { return CountTuples<3>(k); }
+  uint64_t CountQuads(const T &k) const { return CountTuples<4>(k); }
+
+  // Call fn(tuple) for each distinct multiset of values summing to k, in
+  // increasing order of the first value. fn may return bool; returning false
+  // stops the search.
+  template <ResultSink<Pair> Fn> void ForEachPair(const T &k, Fn &&fn) const {
+    ForEachTuple<2>(k, fn);
+  }
+  template <ResultSink<Triple> Fn>
+  void ForEachTriple(const T &k, Fn &&fn) const {
+    ForEachTuple<3>(k, fn);
+  }
+  template <ResultSink<Quad> Fn> void ForEachQuad(const T &k, Fn &&fn) const {
+    ForEachTuple<4>(k, fn);
+  }
+  std::vector<Pair> AllPairs(const T &k) const;
+  std::vector<Triple> AllTriples(const T &k) const;
+  std::vector<Quad> AllQuads(const T &k) const;
+
+  // --- Batches ---
+  // Entry i answers targets[i]. Targets are handed out to up to `threads`
+  // threads (0 = one per hardware thread) in small blocks, since their cost
+  // varies with how soon a pair turns up.
+  std::vector<std::optional<Pair>> FindPairs(std::span<const T> targets,
+                                             size_t threads = 1) const;
+  std::vector<uint64_t> CountPairs(std::span<const T> targets,
+                                   size_t threads = 1) const;
+  std::vector<uint64_t> CountTriples(std::span<const T> targets,
+                                     size_t threads = 1) const;
+
+private:
+  std::vector<T> values;         // distinct, increasing
+  std::vector<size_t> counts;    // counts[i]: occurrences of values[i]
+  FlatHashMap<T, size_t> index;  // value -> position in values
+  size_t size = 0;
+
+  // Calls fn(positions) for each nondecreasing K-tuple of positions into
+  // `values` whose values sum to `target` and that uses no value more often
+  // than it occurs. Returns false if fn stopped the search.
+  template <size_t K, typename Fn>
+  bool Search(Sum target, Fn &fn) const;
+  template <size_t K, size_t D, typename Fn>
+  bool SearchFrom(std::array<size_t, K> &at, size_t first, Sum target,
+                  Fn &fn) const;
+  template <size_t K> bool Fits(const std::array<size_t, K> &at) const;
+
+  // Answers count targets at once; see FindPair.
+  void FindPairBlock(const T *targets, size_t count,
+                     std::optional<Pair> *out) const;
+  std::optional<Pair> FindSelfPair(Sum target) const;
+
+  template <size_t K> uint64_t CountTuples(const T &k) const;
+  template <size_t K, typename Fn> void ForEachTuple(const T &k, Fn &fn) const;
+  template <typename R, typename Query>
+  std::vector<R> Batch(std::span<const T> targets, size_t threads,
+                       Query query) const;
+};
+
+// =================================================================================
+// ================================ IMPLEMENTATION =================================
+// =================================================================================
+
+template <typename T> SumIndex<T>::SumIndex(const Array<T> &arr) {
+  std::vector<T> sorted(arr.begin(), arr.end());
+  std::sort(sorted.begin(), sorted.end());
+  size = sorted.size();
+  for (size_t i = 0; i < sorted.size();) {
+    size_t j = i + 1;
+    while (j < sorted.size() && sorted[j] == sorted[i])
+      ++j;
+    values.push_back(sorted[i]);
+    counts.push_back(j - i);
+    i = j;
+  }
+  index.Reserve(values.size());
+  for (size_t i = 0; i < values.size(); ++i)
+    index.Insert(values[i], i);
+}
+
+template <typename T> size_t SumIndex<T>::Count(const T &value) const {
+  const size_t *at = index.Find(value);
+  return at ? counts[*at] : 0;
+}
+
+// Independent two-pointer scans interleaved in one loop. A single scan is a
+// chain of dependent loads and compares, so it leaves most of the CPU idle;
+// stepping several scans side by side lets their latencies overlap.
+inline constexpr size_t kSumLanes = 8;
+
+template <typename T>
+std::optional<typename SumIndex<T>::Pair>
+SumIndex<T>::FindPair(const T &k) const {
+  std::optional<Pair> pair;
+  FindPairBlock(&k, 1, &pair);
+  return pair;
+}
+
+template <typename T>
+void SumIndex<T>::FindPairBlock(const T *targets, size_t count,
+                                std::optional<Pair> *out) const {
+  if (values.empty()) {
+    std::fill(out, out + count, std::nullopt);
+    return;
+  }
+  for (size_t first = 0; first < count; first += kSumLanes) {
+    const size_t lanes = std::min(kSumLanes, count - first);
+    // Unused lanes start with lo == hi and never step.
+    Sum target[kSumLanes] = {};
+    size_t lo[kSumLanes] = {}, hi[kSumLanes] = {};
+    bool hit[kSumLanes] = {};
+    for (size_t l = 0; l < lanes; ++l) {
+      target[l] = targets[first + l];
+      hi[l] = values.size() - 1;
+    }
+    // Pointer moves are arithmetic, not branches. A lane that hits stops
+    // moving, since its sum is neither below nor above the target.
+    for (bool active = true; active;) {
+      active = false;
+      for (size_t l = 0; l < kSumLanes; ++l) {
+        bool live = lo[l] < hi[l] && !hit[l];
+        Sum sum = Sum(values[lo[l]]) + Sum(values[hi[l]]);
+        hit[l] |= live && sum == target[l];
+        lo[l] += live && sum < target[l];
+        hi[l] -= live && sum > target[l];
+        active |= live;
+      }
+    }
+    for (size_t l = 0; l < lanes; ++l)
+      out[first + l] = hit[l] ? Pair{values[lo[l]], values[hi[l]]}
+                              : FindSelfPair(target[l]);
+  }
+}
+
+// The pair of one value with itself: only k / 2 can form it.
+template <typename T>
+std::optional<typename SumIndex<T>::Pair>
+SumIndex<T>::FindSelfPair(Sum target) const {
+  if constexpr (std::is_integral_v<T>) {
+    if (target % 2 != 0)
+      return std::nullopt;
+  }
+  const Sum half = target / 2;
+  if (half < Sum(values.front()) || half > Sum(values.back()))
+    return std::nullopt;
+  const T v = static_cast<T>(half);
+  if (Sum(v) + Sum(v) == target && Count(v) >= 2)
+    return Pair{v, v};
+  return std::nullopt;
+}
+
+template <typename T>
+template <size_t K>
+bool SumIndex<T>::Fits(const std::array<size_t, K> &at) const {
+  // Positions are nondecreasing, so repeats are adjacent.
+  for (size_t i = 0; i < K;) {
+    size_t j = i + 1;
+    while (j < K && at[j] == at[i])
+      ++j;
+    if (j - i > counts[at[i]])
+      return false;
+    i = j;
+  }
+  return true;
+}
+
+template <typename T>
+template <size_t K, size_t D, typename Fn>
+bool SumIndex<T>::SearchFrom(std::array<size_t, K> &at, size_t first,
+                             Sum target, Fn &fn) const {
+  constexpr size_t kLeft = K - D; // values still to choose
+  const size_t d = values.size();
+  if constexpr (kLeft == 2) {
+    if (first >= d)
+      return true;
+    size_t lo = first, hi = d - 1;
+    while (lo <= hi) {
+      Sum sum = Sum(values[lo]) + Sum(values[hi]);
+      if (sum < target) {
+        ++lo;
+      } else if (sum > target) {
+        if (hi == lo)
+          break;
+        --hi;
+      } else {
+        at[D] = lo;
+        at[D + 1] = hi;
+        if (Fits(at) && !fn(at))
+          return false;
+        if (hi == lo)
+          break;
+        ++lo;
+        --hi;
+      }
+    }
+    return true;
+  } else {
+    for (size_t i = first; i < d; ++i) {
+      // The rest are at least values[i] each, and at most the largest value.
+      Sum low = Sum(values[i]) * Sum(kLeft);
+      Sum high = Sum(values[i]) + Sum(values[d - 1]) * Sum(kLeft - 1);
+      if (low > target)
+        break;
+      if (high < target)
+        continue;
+      at[D] = i;
+      if (!SearchFrom<K, D + 1>(at, i, target - Sum(values[i]), fn))
+        return false;
+    }
+    return true;
+  }
+}
+
+template <typename T>
+template <size_t K, typename Fn>
+bool SumIndex<T>::Search(Sum target, Fn &fn) const {
+  std::array<size_t, K> at{};
+  return SearchFrom<K, 0>(at, 0, target, fn);
+}
+
+template <typename T>
+template <size_t K>
+uint64_t SumIndex<T>::CountTuples(const T &k) const {
+  uint64_t total = 0;
+  auto add = [&](const std::array<size_t, K> &at) {
+    // Choose which occurrences of each repeated value the tuple uses.
+    uint64_t ways = 1;
+    for (size_t i = 0; i < K;) {
+      size_t j = i + 1;
+      while (j < K && at[j] == at[i])
+        ++j;
+      ways *= sum_index_detail::Choose(counts[at[i]], j - i);
+      i = j;
+    }
+    total += ways;
+    return true;
+  };
+  Search<K>(Sum(k), add);
+  return total;
+}
+
+template <typename T>
+template <size_t K, typename Fn>
+void SumIndex<T>::ForEachTuple(const T &k, Fn &fn) const {
+  auto emit = [&](const std::array<size_t, K> &at) {
+    std::array<T, K> tuple;
+    for (size_t i = 0; i < K; ++i)
+      tuple[i] = values[at[i]];
+    if constexpr (K == 2) {
+      const Pair pair{tuple[0], tuple[1]};
+      return invoke_sink(fn, pair);
+    } else {
+      return invoke_sink(fn, std::as_const(tuple));
+    }
+  };
+  Search<K>(Sum(k), emit);
+}
+
+template <typename T>
+std::vector<typename SumIndex<T>::Pair>
+SumIndex<T>::AllPairs(const T &k) const {
+  std::vector<Pair> out;
+  ForEachPair(k, [&](const Pair &p) { out.push_back(p); });
+  return out;
+}
+
+template <typename T>
+std::vector<typename SumIndex<T>::Triple>
+SumIndex<T>::AllTriples(const T &k) const {
+  std::vector<Triple> out;
+  ForEachTriple(k, [&](const Triple &t) { out.push_back(t); });
+  return out;
+}
+
+template <typename T>
+std::vector<typename SumIndex<T>::Quad>
+SumIndex<T>::AllQuads(const T &k) const {
+  std::vector<Quad> out;
+  ForEachQuad(k, [&](const Quad &q) { out.push_back(q); });
+  return out;
+}
+
+// Targets per block claimed by a batch thread; `query` answers one block.
+inline constexpr size_t kSumBatchBlock = 16;
+
+template <typename T>
+template <typename R, typename Query>
+std::vector<R> SumIndex<T>::Batch(std::span<const T> targets, size_t threads,
+                                  Query query) const {
+  std::vector<R> results(targets.size());
+  const size_t blocks = (targets.size() + kSumBatchBlock - 1) / kSumBatchBlock;
+  std::atomic<size_t> next_block{0};
+  parallel_for(std::min(resolve_thread_count(threads), blocks), [&](size_t) {
+    for (size_t b; (b = next_block.fetch_add(1)) < blocks;) {
+      size_t first = b * kSumBatchBlock;
+      size_t last = std::min(targets.size(), first + kSumBatchBlock);
+      query(targets.data() + first, last - first, results.data() + first);
+    }
+  });
+  return results;
+}
+
+template <typename T>
+std::vector<std::optional<typename SumIndex<T>::Pair>>
+SumIndex<T>::FindPairs(std::span<const T> targets, size_t threads) const {
+  return Batch<std::optional<Pair>>(
+      targets, threads,
+      [this](const T *first, size_t count, std::optional<Pair> *out) {
+        FindPairBlock(first, count, out);
+      });
+}
+
+template <typename T>
+std::vector<uint64_t> SumIndex<T>::CountPairs(std::span<const T> targets,
+                                              size_t threads) const {
+  return Batch<uint64_t>(
+      targets, threads, [this](const T *first, size_t count, uint64_t *out) {
+        for (size_t i = 0; i < count; ++i)
+          out[i] = CountPairs(first[i]);
+      });
+}
+
+template <typename T>
+std::vector<uint64_t> SumIndex<T>::CountTriples(std::span<const T> targets,
+                                                size_t threads) const {
+  return Batch<uint64_t>(
+      targets, threads, [this](const T *first, size_t count, uint64_t *out) {
+        for (size_t i = 0; i < count; ++i)
+          out[i] = CountTriples(first[i]);
+      });
+}
+
+#endif // SUM_INDEX_H
@@ -79,6 +79,41 @@ Array<int> create_and_fill_array(size_t expected_size, bool must_be_sorted) {
     return arr;
 }
 
+// --- Printers for the missing/duplicate finders ---
+// Single values print on their own, longer gaps as "first..last".
+void print_missing_ranges(const string& label, const std::vector<MissingRange<int>>& ranges) {
+    cout << label;
+    if (ranges.empty()) {
+        cout << "None found.";
+    }
+    for (const auto& range : ranges) {
+        if (range.hi - range.lo == 1) cout << range.lo << " ";
+        else cout << range.lo << ".." << (range.hi - 1) << " ";
+    }
+    cout << endl;
+}
+
+void print_duplicate_runs(const std::vector<DuplicateRun<int>>& runs) {
+    if (runs.empty()) {
+        cout << "No duplicates found." << endl;
+        return;
+    }
+    for (const auto& run : runs) {
+        cout << "Duplicate value: " << run.value << "\nOccurrences: " << run.count
+        << " times." << endl;
+    }
+}
+
+void print_char_counts(const std::vector<CharCount>& duplicates) {
+    if (duplicates.empty()) {
+        cout << "No duplicate alphabetic characters found." << endl;
+        return;
+    }
+    for (const auto& entry : duplicates) {
+        cout << "Character: '" << entry.character << "', Occurences: " << entry.count << endl;
+    }
+}
+
 void demonstrate_string_algorithms() {
     cout << "\n--- Demonstrating String Algorithms ---" << endl;
     
@@ -106,14 +141,14 @@ void demonstrate_string_algorithms() {
     cout << "Testing string: \"" << dup_str_complex << "\"\n" << endl;
     
     cout << "--- Hashing Method Output ---" << endl;
-    find_duplicates_hashing(dup_str_complex);
+    print_char_counts(find_duplicates_hashing(dup_str_complex));
     
     cout << "\n--- Bitwise Method Output ---" << endl;
-    find_duplicates_bitwise(dup_str_complex);
+    print_char_counts(find_duplicates_bitwise(dup_str_complex));
     
     cout << "Testing string with no alphabetic duplicates in hashing method..." << endl;
     std::string dup_str_simple = "JUMPING!";
-    find_duplicates_hashing(dup_str_simple);
+    print_char_counts(find_duplicates_hashing(dup_str_simple));
     
     // 4. --- Testing are_anagrams (hashing method) ---
     std::string ana1 = "decimal";
@@ -285,6 +320,10 @@ int main() {
         cout << "27. Find Pair with Sum K\n";
         cout << "28. Find Min and Max (Single Scan) K\n";
         
+        // Selection
+        cout << "29. Find K-th Smallest (Introselect)\n";
+        cout << "30. Find Top K Largest\n";
+        
         // Exit
         cout << "0. Exit\n";
         cout << "==========================\n";
@@ -461,18 +500,23 @@ int main() {
                 if (!arr1.isSorted()) {
                     cout << "ERROR: Array must be sorted for this method.\n";
                 } else {
-                    arr1.FindMultipleMissingElementsSorted();
+                    print_missing_ranges("Missing elements (Sorted Method): ",
+                                         arr1.FindMultipleMissingElementsSorted());
                 }
                 break;
             case 24: // Find Multiple Missing Elements in an Unsorted Hash map
-                arr1.FindMultipleMissingElementsHash();
+                if (arr1.GetLength() == 0) {
+                    cout << "Array is empty." << endl; break;
+                }
+                print_missing_ranges("Missing elements (Hash method): ",
+                                     arr1.FindMultipleMissingElementsHash());
                 break;
             case 25: // Find duplicates in a sorted array
                 if (!arr1.isSorted()) {
                     cout << "ERROR: Array must be sorted to find duplicates using this method.\n";
                     cout << "Please sort the first array or use a method for unsorted arrays.\n";
                 } else {
-                    arr1.FindDuplicatesSorted();
+                    print_duplicate_runs(arr1.FindDuplicatesSorted());
                 }
                 break;
             case 26: // Count duplicates
@@ -522,6 +566,33 @@ int main() {
                 }
                 break;
             }
+            case 29:
+            {
+                if (arr1.GetLength() == 0) {
+                    cout << "Array is empty." << endl;
+                    break;
+                }
+                int k = get_validated_integer("Enter k (0-based, 0 = smallest): ", 0,
+                                              static_cast<int>(arr1.GetLength()) - 1);
+                if (intend_to_be_sorted && arr1.isSorted()) {
+                    // Already in order: selection would only shuffle the array.
+                    cout << "K-th smallest element: " << *arr1.Get(static_cast<size_t>(k)) << endl;
+                    break;
+                }
+                int kth = arr1.NthElement(static_cast<size_t>(k));
+                cout << "K-th smallest element: " << kth << endl;
+                cout << "Array after selection (partitioned around index " << k << "):" << endl;
+                arr1.Display();
+                break;
+            }
+            case 30:
+            {
+                int k = get_validated_integer("Enter k: ", 0);
+                Array<int> top = arr1.TopK(static_cast<size_t>(k));
+                cout << "Top " << top.GetLength() << " (descending): ";
+                top.Display();
+                break;
+            }
             case 0: cout << "Exiting program." << endl; break;
             default: cout << "Invalid choice. Please try again." << endl; break;
         }